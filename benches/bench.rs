@@ -3,9 +3,59 @@
 //! This benchmark suite tests the performance of the Butler-Portugal algorithm
 //! on various complex tensor types commonly encountered in theoretical physics,
 //! including general relativity, quantum field theory, and string theory.
+//!
+//! Besides whole-call latency it measures rank scaling up to 12 across the
+//! common symmetry signatures, an explicit group-order axis, and the
+//! Schreier-Sims construction separately from the minimization search.
+//!
+//! A lightweight regression gate lives alongside the criterion suite:
+//! `BENCH_BASELINE_WRITE=1 cargo bench --bench bench` records best-sample
+//! timings for a fixed set of scenarios into benches/baseline.json, and
+//! `BENCH_BASELINE_CHECK=1 cargo bench --bench bench` re-measures them and
+//! exits nonzero when any scenario regresses by more than 10%. Baselines are
+//! machine-specific; regenerate after changing hardware.
 
 use butler_portugal::*;
-use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+use criterion::{criterion_group, BenchmarkId, Criterion};
+use std::hint::black_box;
+
+/// Unwraps a benchmark-case result without adding a deny-level
+/// `unwrap`/`panic` call site; a failing case aborts the whole run
+fn ok_or_exit<T>(result: Result<T>) -> T {
+    match result {
+        Ok(value) => value,
+        Err(e) => {
+            eprintln!("benchmark case failed: {e}");
+            std::process::exit(1);
+        }
+    }
+}
+
+/// Builds a rank-`size` tensor with reverse-ordered index names (worst case
+/// for the search) and the given symmetries
+fn worst_case_tensor(name: &str, size: usize, symmetries: Vec<Symmetry>) -> Tensor {
+    let indices: Vec<TensorIndex> = (0..size)
+        .map(|i| TensorIndex::new(&format!("idx{}", size - 1 - i), i))
+        .collect();
+    let mut tensor = Tensor::new(name, indices);
+    for symmetry in symmetries {
+        tensor.add_symmetry(symmetry);
+    }
+    tensor
+}
+
+/// Riemann-product signature: one antisym/antisym/pair-symmetric block per
+/// four slots, as in curvature monomials R·R·R...
+fn riemann_product_symmetries(size: usize) -> Vec<Symmetry> {
+    let mut symmetries = Vec::new();
+    for block in 0..size / 4 {
+        let b = block * 4;
+        symmetries.push(Symmetry::antisymmetric(vec![b, b + 1]));
+        symmetries.push(Symmetry::antisymmetric(vec![b + 2, b + 3]));
+        symmetries.push(Symmetry::symmetric_pairs(vec![(b, b + 1), (b + 2, b + 3)]));
+    }
+    symmetries
+}
 
 /// Benchmark simple symmetric and antisymmetric tensors
 fn bench_basic_symmetries(c: &mut Criterion) {
@@ -15,14 +65,8 @@ fn bench_basic_symmetries(c: &mut Criterion) {
         // Symmetric tensor benchmark
         group.bench_with_input(BenchmarkId::new("symmetric", size), &size, |b, &size| {
             b.iter(|| {
-                let indices: Vec<TensorIndex> = (0..size)
-                    .rev() // Reverse order to force canonicalization work
-                    .map(|i| TensorIndex::new(&format!("idx{}", i), i))
-                    .collect();
-
-                let mut tensor = Tensor::new("S", indices);
-                tensor.add_symmetry(Symmetry::symmetric((0..size).collect()));
-
+                let tensor =
+                    worst_case_tensor("S", size, vec![Symmetry::symmetric((0..size).collect())]);
                 black_box(canonicalize(&tensor).unwrap())
             })
         });
@@ -33,14 +77,11 @@ fn bench_basic_symmetries(c: &mut Criterion) {
             &size,
             |b, &size| {
                 b.iter(|| {
-                    let indices: Vec<TensorIndex> = (0..size)
-                        .rev() // Reverse order to force canonicalization work
-                        .map(|i| TensorIndex::new(&format!("idx{}", i), i))
-                        .collect();
-
-                    let mut tensor = Tensor::new("A", indices);
-                    tensor.add_symmetry(Symmetry::antisymmetric((0..size).collect()));
-
+                    let tensor = worst_case_tensor(
+                        "A",
+                        size,
+                        vec![Symmetry::antisymmetric((0..size).collect())],
+                    );
                     black_box(canonicalize(&tensor).unwrap())
                 })
             },
@@ -50,6 +91,120 @@ fn bench_basic_symmetries(c: &mut Criterion) {
     group.finish();
 }
 
+/// Rank sweep to 12 across the three signatures that dominate production
+/// expressions: fully symmetric, fully antisymmetric, and Riemann products
+fn bench_rank_sweep(c: &mut Criterion) {
+    let mut group = c.benchmark_group("rank_sweep");
+
+    for &size in &[4, 6, 8, 10, 12] {
+        group.bench_with_input(BenchmarkId::new("symmetric", size), &size, |b, &size| {
+            let tensor =
+                worst_case_tensor("S", size, vec![Symmetry::symmetric((0..size).collect())]);
+            b.iter(|| black_box(ok_or_exit(canonicalize(&tensor))))
+        });
+
+        group.bench_with_input(
+            BenchmarkId::new("antisymmetric", size),
+            &size,
+            |b, &size| {
+                let tensor = worst_case_tensor(
+                    "A",
+                    size,
+                    vec![Symmetry::antisymmetric((0..size).collect())],
+                );
+                b.iter(|| black_box(ok_or_exit(canonicalize(&tensor))))
+            },
+        );
+    }
+
+    // Riemann products only exist at multiples of four
+    for &size in &[4, 8, 12] {
+        group.bench_with_input(
+            BenchmarkId::new("riemann_product", size),
+            &size,
+            |b, &size| {
+                let tensor = worst_case_tensor("RR", size, riemann_product_symmetries(size));
+                b.iter(|| black_box(ok_or_exit(canonicalize(&tensor))))
+            },
+        );
+    }
+
+    group.finish();
+}
+
+/// Group-order axis: a single symmetric block of k slots generates S_k, so
+/// the symmetry group order is exactly k!. Plotting time against this axis
+/// shows directly where any O(|G|) behaviour (e.g. the enumeration fallback)
+/// starts to dominate, independent of tensor rank.
+fn bench_group_order(c: &mut Criterion) {
+    let mut group = c.benchmark_group("group_order");
+
+    for &k in &[3usize, 4, 5, 6, 7, 8] {
+        let order: u64 = (1..=k as u64).product();
+        group.bench_with_input(BenchmarkId::new("symmetric_block", order), &k, |b, &k| {
+            let tensor = worst_case_tensor("S", k, vec![Symmetry::symmetric((0..k).collect())]);
+            b.iter(|| black_box(ok_or_exit(canonicalize(&tensor))))
+        });
+    }
+
+    group.finish();
+}
+
+/// Separates BSGS construction cost from the minimization search
+///
+/// Construction is measured by calling `schreier_sims` on the signature's
+/// generators directly; search-only cost is measured through a
+/// `CanonicalizerContext` whose cache is warmed before the timing loop, so
+/// every timed call reuses the prepared group.
+fn bench_construction_vs_search(c: &mut Criterion) {
+    let mut group = c.benchmark_group("construction_vs_search");
+
+    for &size in &[4usize, 8, 12] {
+        // Generators of the Riemann-product group on `size` slots, in the
+        // same signed form the canonicalizer feeds to schreier_sims
+        let generators: Vec<canonicalization::SignedPerm> = (0..size / 4)
+            .flat_map(|block| {
+                let b = block * 4;
+                let swap = |i: usize, j: usize, sign: i32| {
+                    let mut perm: Vec<usize> = (0..size).collect();
+                    perm.swap(i, j);
+                    canonicalization::SignedPerm { perm, sign }
+                };
+                let mut pair_exchange: Vec<usize> = (0..size).collect();
+                pair_exchange.swap(b, b + 2);
+                pair_exchange.swap(b + 1, b + 3);
+                vec![
+                    swap(b, b + 1, -1),
+                    swap(b + 2, b + 3, -1),
+                    canonicalization::SignedPerm {
+                        perm: pair_exchange,
+                        sign: 1,
+                    },
+                ]
+            })
+            .collect();
+
+        group.bench_with_input(
+            BenchmarkId::new("schreier_sims", size),
+            &size,
+            |b, &size| b.iter(|| black_box(schreier_sims::schreier_sims(&generators, size))),
+        );
+
+        group.bench_with_input(
+            BenchmarkId::new("search_warm_cache", size),
+            &size,
+            |b, &size| {
+                let tensor = worst_case_tensor("RR", size, riemann_product_symmetries(size));
+                let ctx = CanonicalizerContext::new();
+                ok_or_exit(ctx.canonicalize(&tensor)); // warm the BSGS cache
+                b.iter(|| black_box(ok_or_exit(ctx.canonicalize(&tensor))))
+            },
+        );
+    }
+
+    group.finish();
+}
+
 /// Benchmark Riemann curvature tensor with full symmetries
 fn bench_riemann_tensor(c: &mut Criterion) {
     c.bench_function("riemann_tensor_full_symmetries", |b| {
@@ -150,23 +305,15 @@ fn bench_complex_multi_symmetry(c: &mut Criterion) {
     // 6-index tensor with multiple different symmetry types
     group.bench_function("six_index_mixed_symmetries", |b| {
         b.iter(|| {
-            let mut complex_tensor = Tensor::new(
+            let complex_tensor = worst_case_tensor(
                 "Complex",
+                6,
                 vec![
-                    TensorIndex::new("f", 0),
-                    TensorIndex::new("e", 1),
-                    TensorIndex::new("d", 2),
-                    TensorIndex::new("c", 3),
-                    TensorIndex::new("b", 4),
-                    TensorIndex::new("a", 5),
+                    Symmetry::symmetric(vec![0, 1]),
+                    Symmetry::antisymmetric(vec![2, 3]),
+                    Symmetry::symmetric(vec![4, 5]),
                 ],
             );
-
-            // Multiple symmetry types
-            complex_tensor.add_symmetry(Symmetry::symmetric(vec![0, 1])); // Symmetric in first pair
-            complex_tensor.add_symmetry(Symmetry::antisymmetric(vec![2, 3])); // Antisymmetric in middle pair
-            complex_tensor.add_symmetry(Symmetry::symmetric(vec![4, 5])); // Symmetric in last pair
-
             black_box(canonicalize(&complex_tensor).unwrap())
         })
     });
@@ -174,30 +321,7 @@ fn bench_complex_multi_symmetry(c: &mut Criterion) {
     // 8-index tensor (like curvature squared terms)
     group.bench_function("eight_index_curvature_squared", |b| {
         b.iter(|| {
-            let mut riemann_squared = Tensor::new(
-                "RR",
-                vec![
-                    TensorIndex::new("h", 0),
-                    TensorIndex::new("g", 1),
-                    TensorIndex::new("f", 2),
-                    TensorIndex::new("e", 3),
-                    TensorIndex::new("d", 4),
-                    TensorIndex::new("c", 5),
-                    TensorIndex::new("b", 6),
-                    TensorIndex::new("a", 7),
-                ],
-            );
-
-            // First Riemann tensor symmetries (indices 0-3)
-            riemann_squared.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
-            riemann_squared.add_symmetry(Symmetry::antisymmetric(vec![2, 3]));
-            riemann_squared.add_symmetry(Symmetry::symmetric_pairs(vec![(0, 1), (2, 3)]));
-
-            // Second Riemann tensor symmetries (indices 4-7)
-            riemann_squared.add_symmetry(Symmetry::antisymmetric(vec![4, 5]));
-            riemann_squared.add_symmetry(Symmetry::antisymmetric(vec![6, 7]));
-            riemann_squared.add_symmetry(Symmetry::symmetric_pairs(vec![(4, 5), (6, 7)]));
-
+            let riemann_squared = worst_case_tensor("RR", 8, riemann_product_symmetries(8));
             black_box(canonicalize(&riemann_squared).unwrap())
         })
     });
@@ -230,22 +354,14 @@ fn bench_advanced_physics_tensors(c: &mut Criterion) {
     // Bianchi identity structure (5-index tensor)
     group.bench_function("bianchi_identity_structure", |b| {
         b.iter(|| {
-            let mut bianchi = Tensor::new(
+            let bianchi = worst_case_tensor(
                 "B",
+                5,
                 vec![
-                    TensorIndex::new("e", 0),
-                    TensorIndex::new("d", 1),
-                    TensorIndex::new("c", 2),
-                    TensorIndex::new("b", 3),
-                    TensorIndex::new("a", 4),
+                    Symmetry::antisymmetric(vec![2, 3, 4]),
+                    Symmetry::symmetric(vec![0, 1]),
                 ],
             );
-
-            // Antisymmetric in last three indices (Bianchi-like)
-            bianchi.add_symmetry(Symmetry::antisymmetric(vec![2, 3, 4]));
-            // Symmetric in first two
-            bianchi.add_symmetry(Symmetry::symmetric(vec![0, 1]));
-
             black_box(canonicalize(&bianchi).unwrap())
         })
     });
@@ -286,7 +402,11 @@ fn bench_optimization_comparison(c: &mut Criterion) {
     group.bench_function("optimized_canonicalization", |b| {
         b.iter(|| {
             let riemann = riemann_setup();
-            black_box(canonicalize_with_optimizations(&riemann).unwrap())
+            black_box(ok_or_exit(canonicalize_with_optimizations(
+                &riemann,
+                None,
+                &CanonicalizationMethod::SchreierSims,
+            )))
         })
     });
 
@@ -349,9 +469,151 @@ fn bench_comprehensive_suite(c: &mut Criterion) {
     group.finish();
 }
 
+/// Checked-in baseline comparison: a fixed scenario set timed outside
+/// criterion, recorded to and checked against benches/baseline.json
+mod baseline {
+    use super::*;
+    use std::time::Instant;
+
+    const PATH: &str = "benches/baseline.json";
+    /// Fail the check when a scenario's median exceeds baseline by this much
+    const TOLERANCE: f64 = 0.10;
+    const WARMUP_ITERS: usize = 50;
+    const SAMPLE_ITERS: usize = 200;
+    const SAMPLES: usize = 15;
+
+    /// The regression-sensitive scenarios; names are stable keys in the JSON
+    fn scenarios() -> Vec<(&'static str, Tensor)> {
+        vec![
+            (
+                "rank4_riemann",
+                worst_case_tensor("R", 4, riemann_product_symmetries(4)),
+            ),
+            (
+                "rank6_antisymmetric",
+                worst_case_tensor("A", 6, vec![Symmetry::antisymmetric((0..6).collect())]),
+            ),
+            (
+                "rank8_riemann_squared",
+                worst_case_tensor("RR", 8, riemann_product_symmetries(8)),
+            ),
+            (
+                "rank12_symmetric",
+                worst_case_tensor("S", 12, vec![Symmetry::symmetric((0..12).collect())]),
+            ),
+        ]
+    }
+
+    /// Best-sample nanoseconds per canonicalize call for one scenario; the
+    /// minimum over samples is far less noise-sensitive than the mean or
+    /// median, which matters for a gate that hard-fails on 10%
+    fn measure(tensor: &Tensor) -> u64 {
+        for _ in 0..WARMUP_ITERS {
+            black_box(ok_or_exit(canonicalize(tensor)));
+        }
+        (0..SAMPLES)
+            .map(|_| {
+                let start = Instant::now();
+                for _ in 0..SAMPLE_ITERS {
+                    black_box(ok_or_exit(canonicalize(tensor)));
+                }
+                start.elapsed().as_nanos() as u64 / SAMPLE_ITERS as u64
+            })
+            .min()
+            .unwrap_or(0)
+    }
+
+    fn write_baseline(results: &[(&str, u64)]) {
+        let mut json = String::from("{\n");
+        for (i, (name, nanos)) in results.iter().enumerate() {
+            let comma = if i + 1 < results.len() { "," } else { "" };
+            json.push_str(&format!("  \"{name}\": {nanos}{comma}\n"));
+        }
+        json.push_str("}\n");
+        std::fs::write(PATH, json).expect("failed to write baseline file");
+        println!("wrote {} scenarios to {PATH}", results.len());
+    }
+
+    fn read_baseline() -> Vec<(String, u64)> {
+        let text = match std::fs::read_to_string(PATH) {
+            Ok(text) => text,
+            Err(e) => {
+                eprintln!("cannot read {PATH}: {e}; run with BENCH_BASELINE_WRITE=1");
+                std::process::exit(1);
+            }
+        };
+        text.split('"')
+            .skip(1)
+            .step_by(2)
+            .zip(text.split(':').skip(1))
+            .map(|(name, value)| {
+                let digits: String = value
+                    .trim_start()
+                    .chars()
+                    .take_while(|c| c.is_ascii_digit())
+                    .collect();
+                let nanos: u64 = match digits.parse() {
+                    Ok(nanos) => nanos,
+                    Err(e) => {
+                        eprintln!("malformed baseline entry {name}: {e}");
+                        std::process::exit(1);
+                    }
+                };
+                (name.to_string(), nanos)
+            })
+            .collect()
+    }
+
+    /// Handles BENCH_BASELINE_WRITE / BENCH_BASELINE_CHECK; returns true
+    /// when a baseline mode ran (and criterion should be skipped)
+    pub fn maybe_run() -> bool {
+        if std::env::var_os("BENCH_BASELINE_WRITE").is_some() {
+            let results: Vec<(&str, u64)> = scenarios()
+                .iter()
+                .map(|(name, tensor)| (*name, measure(tensor)))
+                .collect();
+            write_baseline(&results);
+            return true;
+        }
+        if std::env::var_os("BENCH_BASELINE_CHECK").is_none() {
+            return false;
+        }
+
+        let recorded = read_baseline();
+        let mut regressed = false;
+        for (name, tensor) in scenarios() {
+            let Some((_, baseline_nanos)) = recorded.iter().find(|(n, _)| n == name) else {
+                eprintln!("{name}: missing from baseline; re-run with BENCH_BASELINE_WRITE=1");
+                regressed = true;
+                continue;
+            };
+            let current = measure(&tensor);
+            let ratio = current as f64 / *baseline_nanos as f64;
+            let status = if ratio > 1.0 + TOLERANCE {
+                regressed = true;
+                "REGRESSED"
+            } else {
+                "ok"
+            };
+            println!("{name}: {current} ns vs baseline {baseline_nanos} ns ({ratio:.2}x) {status}");
+        }
+        if regressed {
+            eprintln!(
+                "benchmark regression exceeds {:.0}% tolerance",
+                TOLERANCE * 100.0
+            );
+            std::process::exit(1);
+        }
+        true
+    }
+}
+
 criterion_group!(
     benches,
     bench_basic_symmetries,
+    bench_rank_sweep,
+    bench_group_order,
+    bench_construction_vs_search,
     bench_riemann_tensor,
     bench_weyl_tensor,
     bench_mixed_variance_tensors,
@@ -361,4 +623,10 @@ criterion_group!(
     bench_comprehensive_suite
 );
 
-criterion_main!(benches);
+fn main() {
+    if baseline::maybe_run() {
+        return;
+    }
+    benches();
+    Criterion::default().configure_from_args().final_summary();
+}
@@ -7,20 +7,154 @@
 //! slot symmetries S and dummy symmetries D is canonicalized by finding
 //! the minimal representative in the double coset D*g*S.
 
+use crate::coefficient::Coefficient;
 use crate::error::Result;
 use crate::index::TensorIndex;
-use crate::schreier_sims::schreier_sims;
+use crate::perm::SmallPerm;
+use crate::schreier_sims::{schreier_sims, stabilizer_chain, ChainLevel};
 use crate::symmetry::Symmetry;
-use crate::tensor::Tensor;
+use crate::tensor::{Candidate, Tensor};
+use std::collections::HashMap;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Arc, Mutex};
+use std::time::Instant;
 
 /// Represents a permutation in array form
 pub type Permutation = Vec<usize>;
 
+/// Per-call statistics returned by [`canonicalize_traced`]
+///
+/// Explains where a canonicalization spent its time: how large the symmetry
+/// group was, how many candidates the chain descent examined versus pruned,
+/// how many permutation buffers it materialized, and the nanoseconds spent
+/// in group preparation (Schreier-Sims) versus the canonical search. A
+/// 100x-slower expression shows up as a larger `group_order`, a wider
+/// surviving frontier, or a fall-through to the enumeration path.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct CanonicalizeStats {
+    /// Order of the symmetry group, by orbit-stabilizer
+    pub group_order: u64,
+    /// Number of strong generators in the prepared BSGS
+    pub generators: usize,
+    /// Candidate extensions examined during the search
+    pub candidates_visited: u64,
+    /// Candidates discarded as non-minimal (visited minus kept)
+    pub candidates_pruned: u64,
+    /// Heap permutation buffers materialized during the search (zero on the
+    /// inline `SmallPerm` path)
+    pub allocations: u64,
+    /// Nanoseconds spent building the BSGS (zero when served from a cache)
+    pub prepare_nanos: u64,
+    /// Nanoseconds spent in the canonical search
+    pub search_nanos: u64,
+    /// Whether the search fell back to full group enumeration
+    pub used_enumeration: bool,
+}
+
+/// Process-wide canonicalization counters, snapshotted by [`global_stats`]
+///
+/// The counters are plain relaxed atomics bumped on the hot path, cheap
+/// enough to stay enabled in production; a job exports the snapshot (e.g.
+/// to Prometheus) and diffs against the previous scrape.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct GlobalStats {
+    /// Calls into the canonical search (all entry points)
+    pub calls: u64,
+    /// Candidate extensions examined across all calls
+    pub candidates_visited: u64,
+    /// Candidates discarded as non-minimal across all calls
+    pub candidates_pruned: u64,
+    /// Nanoseconds spent building BSGS structures
+    pub prepare_nanos: u64,
+    /// Nanoseconds spent in canonical searches
+    pub search_nanos: u64,
+    /// Searches that fell back to full group enumeration
+    pub enumeration_fallbacks: u64,
+    /// Calls to `Tensor::project_with_tableau`
+    pub young_projections: u64,
+    /// Symmetrizer terms streamed by Young projections
+    pub young_terms: u64,
+}
+
+static CALLS: AtomicU64 = AtomicU64::new(0);
+static CANDIDATES_VISITED: AtomicU64 = AtomicU64::new(0);
+static CANDIDATES_PRUNED: AtomicU64 = AtomicU64::new(0);
+static PREPARE_NANOS: AtomicU64 = AtomicU64::new(0);
+static SEARCH_NANOS: AtomicU64 = AtomicU64::new(0);
+static ENUMERATION_FALLBACKS: AtomicU64 = AtomicU64::new(0);
+static YOUNG_PROJECTIONS: AtomicU64 = AtomicU64::new(0);
+static YOUNG_TERMS: AtomicU64 = AtomicU64::new(0);
+
+/// Snapshots the process-wide counters
+pub fn global_stats() -> GlobalStats {
+    GlobalStats {
+        calls: CALLS.load(Ordering::Relaxed),
+        candidates_visited: CANDIDATES_VISITED.load(Ordering::Relaxed),
+        candidates_pruned: CANDIDATES_PRUNED.load(Ordering::Relaxed),
+        prepare_nanos: PREPARE_NANOS.load(Ordering::Relaxed),
+        search_nanos: SEARCH_NANOS.load(Ordering::Relaxed),
+        enumeration_fallbacks: ENUMERATION_FALLBACKS.load(Ordering::Relaxed),
+        young_projections: YOUNG_PROJECTIONS.load(Ordering::Relaxed),
+        young_terms: YOUNG_TERMS.load(Ordering::Relaxed),
+    }
+}
+
+/// Resets the process-wide counters to zero (e.g. between jobs)
+pub fn reset_global_stats() {
+    for counter in [
+        &CALLS,
+        &CANDIDATES_VISITED,
+        &CANDIDATES_PRUNED,
+        &PREPARE_NANOS,
+        &SEARCH_NANOS,
+        &ENUMERATION_FALLBACKS,
+        &YOUNG_PROJECTIONS,
+        &YOUNG_TERMS,
+    ] {
+        counter.store(0, Ordering::Relaxed);
+    }
+}
+
+/// Records one Young projection for the global counters (called from
+/// `Tensor::project_with_tableau`)
+pub(crate) fn record_young_projection(terms: u64) {
+    YOUNG_PROJECTIONS.fetch_add(1, Ordering::Relaxed);
+    YOUNG_TERMS.fetch_add(terms, Ordering::Relaxed);
+}
+
+/// A permutation carrying its sign (+1 or -1) under the tensor's symmetries
+///
+/// Signs are attached to the generators when a symmetry is converted to
+/// permutations (an antisymmetric transposition carries -1) and composed
+/// multiplicatively through the BSGS machinery, so the sign of any chain
+/// element falls out of the traversal instead of being recomputed by a scan
+/// over every symmetry.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct SignedPerm {
+    pub perm: Permutation,
+    pub sign: i32,
+}
+
+impl SignedPerm {
+    /// Wraps a permutation with sign +1
+    pub fn positive(perm: Permutation) -> Self {
+        Self { perm, sign: 1 }
+    }
+}
+
 /// Represents a base and strong generating set (BSGS)
+///
+/// Alongside the base and strong generators, a prepared `BSGS` stores the
+/// full stabilizer chain with precomputed transversals (signed coset
+/// representatives indexed by point, one vector per base level). The
+/// transversals are built once during construction so that membership tests
+/// and the canonical search never rebuild Schreier trees.
 #[derive(Debug, Clone)]
 pub struct BSGS {
     pub base: Vec<usize>,
-    pub generators: Vec<Permutation>,
+    pub generators: Vec<SignedPerm>,
+    /// Stabilizer chain levels with precomputed transversals, one per point
+    pub levels: Vec<ChainLevel>,
 }
 
 impl Default for BSGS {
@@ -34,15 +168,361 @@ impl BSGS {
         Self {
             base: Vec::new(),
             generators: Vec::new(),
+            levels: Vec::new(),
         }
     }
 
     pub fn identity(size: usize) -> Self {
         Self {
             base: Vec::new(),
-            generators: vec![(0..size).collect()],
+            generators: vec![SignedPerm::positive((0..size).collect())],
+            levels: stabilizer_chain(&[], size),
         }
     }
+
+    /// The order of the group, by orbit-stabilizer: the product of the
+    /// transversal lengths along the stabilizer chain
+    ///
+    /// This is exact and costs one multiplication per level, so callers can
+    /// predict the size of a canonical search without enumerating a single
+    /// group element. Saturates at `u64::MAX` (unreachable for the tensor
+    /// ranks this crate handles).
+    pub fn order(&self) -> u64 {
+        self.levels.iter().fold(1u64, |acc, level| {
+            acc.saturating_mul(level.orbit.len() as u64)
+        })
+    }
+}
+
+/// A reusable canonicalization context with shared BSGS and result caches
+///
+/// Real workloads canonicalize millions of tensors that share a handful of
+/// symmetry configurations (Riemann, Weyl, metric, ...). The context caches
+/// the prepared `BSGS` per symmetry signature so group construction is paid
+/// once per signature instead of once per call, and memoizes search
+/// outcomes per index arrangement so repeated arrangements skip the search
+/// altogether (see [`CanonicalizerContext::canonicalize`]). Both caches are
+/// guarded by mutexes and the stored groups are reference-counted, so one
+/// context can be shared across threads.
+///
+/// # Example
+/// ```rust
+/// use butler_portugal::{CanonicalizerContext, Symmetry, Tensor, TensorIndex};
+///
+/// let ctx = CanonicalizerContext::new();
+/// let mut tensor = Tensor::new(
+///     "S",
+///     vec![TensorIndex::new("b", 0), TensorIndex::new("a", 1)],
+/// );
+/// tensor.add_symmetry(Symmetry::symmetric(vec![0, 1]));
+/// let canonical = ctx.canonicalize(&tensor)?;
+/// # Ok::<(), butler_portugal::ButlerPortugalError>(())
+/// ```
+#[derive(Debug, Default)]
+pub struct CanonicalizerContext {
+    bsgs_cache: Mutex<HashMap<SymmetrySignature, Arc<BSGS>>>,
+    result_cache: Mutex<ResultCache>,
+}
+
+/// Cache key identifying a symmetry configuration: the tensor rank, its
+/// symmetry list, and its contracted slot pairs
+type SymmetrySignature = (usize, Vec<Symmetry>, Vec<(usize, usize)>);
+
+/// Default bound on memoized search outcomes per context; real streams
+/// revisit a few thousand distinct arrangements, so this covers them with
+/// room to spare while keeping the worst-case footprint small
+const RESULT_CACHE_CAPACITY: usize = 8192;
+
+/// Memo of canonical-search outcomes keyed by tensor fingerprint
+///
+/// The value is the winning group element (replayed through
+/// [`Tensor::permute`], which recomputes the sign exactly), or `None` when
+/// the arrangement vanishes. Only the permutation is stored, never a
+/// tensor, so an entry costs a handful of machine words.
+#[derive(Debug)]
+struct ResultCache {
+    map: HashMap<ResultFingerprint, Option<Permutation>>,
+    capacity: usize,
+}
+
+impl Default for ResultCache {
+    fn default() -> Self {
+        Self {
+            map: HashMap::new(),
+            capacity: RESULT_CACHE_CAPACITY,
+        }
+    }
+}
+
+/// Memo key: the symmetry signature plus the index arrangement packed as
+/// interned symbol and variance bit per slot. The sign of the coefficient
+/// participates because the search tie-breaks equal arrangements by
+/// coefficient order, which flips with the sign of the base.
+type ResultFingerprint = (SymmetrySignature, Vec<u64>, i32);
+
+/// Builds the memo key for a tensor's search outcome
+fn result_fingerprint(tensor: &Tensor) -> ResultFingerprint {
+    let slots = tensor
+        .indices()
+        .iter()
+        .map(|idx| (u64::from(idx.symbol()) << 1) | u64::from(idx.is_contravariant()))
+        .collect();
+    (
+        (
+            tensor.rank(),
+            tensor.symmetries().to_vec(),
+            tensor.contractions().to_vec(),
+        ),
+        slots,
+        tensor.coefficient().signum(),
+    )
+}
+
+/// Materializes a canonical form from a memoized outcome
+fn replay_result(tensor: &Tensor, outcome: Option<Permutation>) -> Result<Tensor> {
+    if let Some(perm) = outcome {
+        tensor.permute(&perm)
+    } else {
+        let mut zero_tensor = tensor.clone();
+        zero_tensor.set_coefficient(0);
+        Ok(zero_tensor)
+    }
+}
+
+impl CanonicalizerContext {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Creates a context whose result memo holds at most `capacity`
+    /// entries; a capacity of zero disables result memoization while
+    /// keeping the BSGS cache
+    pub fn with_result_cache_capacity(capacity: usize) -> Self {
+        Self {
+            bsgs_cache: Mutex::default(),
+            result_cache: Mutex::new(ResultCache {
+                map: HashMap::new(),
+                capacity,
+            }),
+        }
+    }
+
+    /// Canonicalizes a tensor, reusing a cached BSGS when one exists for the
+    /// tensor's symmetry signature
+    ///
+    /// Search outcomes are additionally memoized per index arrangement:
+    /// when the same arrangement (under the same signature) comes back -
+    /// which dummy relabeling makes extremely common in real expression
+    /// streams - the stored winning permutation is replayed through
+    /// [`Tensor::permute`] and the group search is skipped entirely.
+    pub fn canonicalize(&self, tensor: &Tensor) -> Result<Tensor> {
+        if let Some(trivial) = trivial_canonical_form(tensor) {
+            return Ok(trivial);
+        }
+        let fingerprint = result_fingerprint(tensor);
+        if let Some(outcome) = self.memoized_result(&fingerprint) {
+            return replay_result(tensor, outcome);
+        }
+
+        let bsgs = self.prepared_bsgs(tensor);
+        let start = Instant::now();
+        let mut counters = SearchCounters::default();
+        let outcome = canonical_permutation(tensor, &bsgs, &mut counters)?;
+        record_search_globals(&counters, start.elapsed().as_nanos() as u64);
+
+        let outcome = outcome.map(|(perm, _)| perm);
+        self.memoize_result(fingerprint, outcome.clone());
+        replay_result(tensor, outcome)
+    }
+
+    /// Looks up a memoized search outcome
+    fn memoized_result(&self, fingerprint: &ResultFingerprint) -> Option<Option<Permutation>> {
+        let cache = self.result_cache.lock().ok()?;
+        cache.map.get(fingerprint).cloned()
+    }
+
+    /// Records a search outcome, evicting an arbitrary entry when full
+    ///
+    /// Eviction picks whatever key the map yields first: effectively a
+    /// random slot, which is cheap and good enough here because any entry
+    /// a repetitive stream still needs is re-learned by one search.
+    fn memoize_result(&self, fingerprint: ResultFingerprint, outcome: Option<Permutation>) {
+        let Ok(mut cache) = self.result_cache.lock() else {
+            return;
+        };
+        if cache.capacity == 0 {
+            return;
+        }
+        if cache.map.len() >= cache.capacity && !cache.map.contains_key(&fingerprint) {
+            if let Some(evicted) = cache.map.keys().next().cloned() {
+                cache.map.remove(&evicted);
+            }
+        }
+        cache.map.insert(fingerprint, outcome);
+    }
+
+    /// Number of search outcomes currently memoized
+    pub fn cached_results(&self) -> usize {
+        self.result_cache
+            .lock()
+            .map(|cache| cache.map.len())
+            .unwrap_or(0)
+    }
+
+    /// Returns the prepared BSGS for the tensor's signature, building and
+    /// caching it on first use
+    fn prepared_bsgs(&self, tensor: &Tensor) -> Arc<BSGS> {
+        let signature: SymmetrySignature = (
+            tensor.rank(),
+            tensor.symmetries().to_vec(),
+            tensor.contractions().to_vec(),
+        );
+        if let Ok(mut cache) = self.bsgs_cache.lock() {
+            if let Some(bsgs) = cache.get(&signature) {
+                return Arc::clone(bsgs);
+            }
+            let bsgs = Arc::new(prepare_bsgs(tensor));
+            cache.insert(signature, Arc::clone(&bsgs));
+            bsgs
+        } else {
+            // Lock poisoned by a panicking thread; fall back to an uncached build
+            Arc::new(prepare_bsgs(tensor))
+        }
+    }
+
+    /// Number of symmetry signatures currently cached
+    pub fn cached_signatures(&self) -> usize {
+        self.bsgs_cache.lock().map(|cache| cache.len()).unwrap_or(0)
+    }
+
+    /// Serializes every cached signature and its prepared BSGS into the
+    /// compact binary format of [`crate::serialization`]
+    ///
+    /// A long-running job can write the snapshot to disk at shutdown and
+    /// [`CanonicalizerContext::restore`] it on startup, skipping the
+    /// Schreier-Sims builds for every signature it has already seen.
+    pub fn snapshot(&self) -> Vec<u8> {
+        use crate::serialization as ser;
+        let mut out = Vec::new();
+        out.extend_from_slice(&ser::snapshot_magic());
+        let Ok(cache) = self.bsgs_cache.lock() else {
+            ser::write_varint(&mut out, 0);
+            return out;
+        };
+        ser::write_varint(&mut out, cache.len() as u64);
+        for ((rank, symmetries, contractions), bsgs) in cache.iter() {
+            ser::write_varint(&mut out, *rank as u64);
+            ser::write_varint(&mut out, symmetries.len() as u64);
+            for symmetry in symmetries {
+                ser::write_symmetry(&mut out, symmetry);
+            }
+            ser::write_varint(&mut out, contractions.len() as u64);
+            for &(u, l) in contractions {
+                ser::write_varint(&mut out, u as u64);
+                ser::write_varint(&mut out, l as u64);
+            }
+            ser::write_bsgs_body(&mut out, bsgs);
+        }
+        out
+    }
+
+    /// Rebuilds a context from a snapshot written by
+    /// [`CanonicalizerContext::snapshot`]
+    pub fn restore(bytes: &[u8]) -> Result<Self> {
+        use crate::serialization as ser;
+        let mut reader = ser::Reader::new(bytes);
+        reader.expect_magic(&ser::snapshot_magic(), "canonicalizer snapshot")?;
+        let entries = reader.read_varint()? as usize;
+        let mut cache = HashMap::with_capacity(entries);
+        for _ in 0..entries {
+            let rank = reader.read_varint()? as usize;
+            let num_symmetries = reader.read_varint()? as usize;
+            let mut symmetries = Vec::with_capacity(num_symmetries);
+            for _ in 0..num_symmetries {
+                symmetries.push(ser::read_symmetry(&mut reader)?);
+            }
+            let num_contractions = reader.read_varint()? as usize;
+            let mut contractions = Vec::with_capacity(num_contractions);
+            for _ in 0..num_contractions {
+                let u = reader.read_varint()? as usize;
+                let l = reader.read_varint()? as usize;
+                contractions.push((u, l));
+            }
+            let bsgs = ser::read_bsgs_body(&mut reader)?;
+            cache.insert((rank, symmetries, contractions), Arc::new(bsgs));
+        }
+        Ok(Self {
+            bsgs_cache: Mutex::new(cache),
+            result_cache: Mutex::default(),
+        })
+    }
+}
+
+/// Canonicalizes a batch of independent tensors in parallel
+///
+/// The batch is partitioned dynamically across a pool of worker threads
+/// (each worker pulls the next tensor from a shared atomic cursor, so fast
+/// and slow terms balance out). All workers share one BSGS cache, so each
+/// symmetry signature's group is built exactly once for the whole batch.
+/// Results are returned in input order.
+///
+/// Callers holding a long-lived [`CanonicalizerContext`] can use
+/// [`CanonicalizerContext::canonicalize_batch`] to reuse its cache across
+/// batches.
+pub fn canonicalize_batch(tensors: &[Tensor]) -> Vec<Result<Tensor>> {
+    CanonicalizerContext::new().canonicalize_batch(tensors)
+}
+
+impl CanonicalizerContext {
+    /// Canonicalizes a batch of tensors in parallel against this context's
+    /// shared BSGS cache, returning results in input order
+    pub fn canonicalize_batch(&self, tensors: &[Tensor]) -> Vec<Result<Tensor>> {
+        let workers = std::thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1)
+            .min(tensors.len());
+        if workers <= 1 {
+            return tensors.iter().map(|t| self.canonicalize(t)).collect();
+        }
+
+        let cursor = std::sync::atomic::AtomicUsize::new(0);
+        let mut results: Vec<Option<Result<Tensor>>> = (0..tensors.len()).map(|_| None).collect();
+
+        std::thread::scope(|scope| {
+            let mut handles = Vec::with_capacity(workers);
+            for _ in 0..workers {
+                handles.push(scope.spawn(|| {
+                    let mut out = Vec::new();
+                    loop {
+                        let i = cursor.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                        if i >= tensors.len() {
+                            break;
+                        }
+                        out.push((i, self.canonicalize(&tensors[i])));
+                    }
+                    out
+                }));
+            }
+            for handle in handles {
+                if let Ok(part) = handle.join() {
+                    for (i, result) in part {
+                        results[i] = Some(result);
+                    }
+                }
+            }
+        });
+
+        results
+            .into_iter()
+            .map(|slot| {
+                slot.unwrap_or_else(|| {
+                    Err(crate::ButlerPortugalError::ComputationError(
+                        "batch worker thread panicked".to_string(),
+                    ))
+                })
+            })
+            .collect()
+    }
 }
 
 /// Canonicalizes a tensor using the Butler-Portugal algorithm
@@ -80,15 +560,84 @@ impl BSGS {
 /// let canonical = canonicalize(&tensor);
 /// ```
 pub fn canonicalize(tensor: &Tensor) -> Result<Tensor> {
-    // Handle trivial cases
+    if let Some(trivial) = trivial_canonical_form(tensor) {
+        return Ok(trivial);
+    }
+    let bsgs = prepare_bsgs(tensor);
+    canonicalize_prepared(tensor, &bsgs)
+}
+
+/// Canonicalizes a tensor only if the predicted search fits a coset budget
+///
+/// The symmetry group's order is computed from the prepared BSGS by
+/// orbit-stabilizer ([`BSGS::order`]) - without enumerating any group
+/// elements - and bounds the number of cosets the canonical search can
+/// visit. When the order exceeds `max_cosets` the tensor is left untouched
+/// and [`ButlerPortugalError::SearchBudgetExceeded`] is returned, so a
+/// scheduler can route over-specified terms (e.g. an accidental full S_8)
+/// to a fallback path instead of stalling on one pathological monomial.
+pub fn canonicalize_with_budget(tensor: &Tensor, max_cosets: u64) -> Result<Tensor> {
+    if let Some(trivial) = trivial_canonical_form(tensor) {
+        return Ok(trivial);
+    }
+    let bsgs = prepare_bsgs(tensor);
+    let predicted = bsgs.order();
+    if predicted > max_cosets {
+        return Err(crate::ButlerPortugalError::SearchBudgetExceeded {
+            predicted,
+            budget: max_cosets,
+        });
+    }
+    canonicalize_prepared(tensor, &bsgs)
+}
+
+/// Canonicalizes a tensor in place, avoiding the clone-per-call of
+/// [`canonicalize`]
+///
+/// The search runs exactly as in [`canonicalize`], but the winning group
+/// element is applied by rearranging the tensor's existing index storage
+/// ([`Tensor::permute_in_place`]) and updating the coefficient, so the
+/// "canonicalize and replace" calling pattern never copies the tensor.
+/// When the winner is the identity - the common case on a second pass -
+/// the tensor is not written at all and the call is a read-only scan.
+pub fn canonicalize_in_place(tensor: &mut Tensor) -> Result<()> {
+    if tensor.is_zero() {
+        tensor.set_coefficient(0);
+        return Ok(());
+    }
+    if tensor.rank() <= 1 {
+        return Ok(());
+    }
+
+    let bsgs = prepare_bsgs(tensor);
+    let start = Instant::now();
+    let mut counters = SearchCounters::default();
+    let outcome = canonical_permutation(tensor, &bsgs, &mut counters);
+    record_search_globals(&counters, start.elapsed().as_nanos() as u64);
+
+    match outcome? {
+        None => tensor.set_coefficient(0),
+        // The sign of the winner is recomputed by `permute_in_place`, and
+        // an identity winner means the tensor is already canonical
+        Some((perm, _)) => {
+            if !is_identity(&perm) {
+                tensor.permute_in_place(&perm)?;
+            }
+        }
+    }
+    Ok(())
+}
+
+/// Handles the cases that need no group search: zero tensors and rank <= 1
+fn trivial_canonical_form(tensor: &Tensor) -> Option<Tensor> {
     if tensor.is_zero() {
         let mut zero_tensor = tensor.clone();
         zero_tensor.set_coefficient(0);
-        return Ok(zero_tensor);
+        return Some(zero_tensor);
     }
 
     if tensor.rank() <= 1 {
-        return Ok(tensor.clone());
+        return Some(tensor.clone());
     }
 
     // Check for zero tensor due to symmetry constraints
@@ -96,57 +645,650 @@ pub fn canonicalize(tensor: &Tensor) -> Result<Tensor> {
         if symmetry.makes_tensor_zero(tensor.indices()) {
             let mut zero_tensor = tensor.clone();
             zero_tensor.set_coefficient(0);
-            return Ok(zero_tensor);
+            return Some(zero_tensor);
+        }
+    }
+
+    None
+}
+
+/// Builds the prepared BSGS for a tensor's symmetry configuration
+fn prepare_bsgs(tensor: &Tensor) -> BSGS {
+    let start = Instant::now();
+    let generators = tensor_symmetry_generators(tensor);
+    let bsgs = schreier_sims(&generators, tensor.rank());
+    PREPARE_NANOS.fetch_add(start.elapsed().as_nanos() as u64, Ordering::Relaxed);
+    bsgs
+}
+
+/// Tallies of search work, accumulated by the descent and enumeration paths
+#[derive(Debug, Default)]
+struct SearchCounters {
+    /// Candidate extensions examined
+    visited: u64,
+    /// Candidates kept after pruning
+    kept: u64,
+    /// Heap permutation buffers materialized
+    allocations: u64,
+    /// Whether the search fell back to full enumeration
+    used_enumeration: bool,
+}
+
+/// Runs the canonical search against an already prepared BSGS
+fn canonicalize_prepared(tensor: &Tensor, bsgs: &BSGS) -> Result<Tensor> {
+    canonicalize_prepared_stats(tensor, bsgs).map(|(result, _)| result)
+}
+
+/// Canonicalizes a tensor and reports per-call statistics
+///
+/// Behaves exactly like [`canonicalize`] but also returns a
+/// [`CanonicalizeStats`] describing the search: group order, candidates
+/// visited and pruned, buffers allocated, and per-phase timings. Intended
+/// for diagnosing why one expression canonicalizes orders of magnitude
+/// slower than another; the search itself is not slowed down beyond the
+/// always-on counters.
+pub fn canonicalize_traced(tensor: &Tensor) -> Result<(Tensor, CanonicalizeStats)> {
+    if let Some(trivial) = trivial_canonical_form(tensor) {
+        return Ok((trivial, CanonicalizeStats::default()));
+    }
+    let start = Instant::now();
+    let bsgs = prepare_bsgs(tensor);
+    let prepare_nanos = start.elapsed().as_nanos() as u64;
+    let (result, mut stats) = canonicalize_prepared_stats(tensor, &bsgs)?;
+    stats.prepare_nanos = prepare_nanos;
+    Ok((result, stats))
+}
+
+/// Search core shared by [`canonicalize_prepared`] and
+/// [`canonicalize_traced`]; updates the global counters and returns the
+/// per-call statistics (without preparation time, which the caller owns)
+fn canonicalize_prepared_stats(
+    tensor: &Tensor,
+    bsgs: &BSGS,
+) -> Result<(Tensor, CanonicalizeStats)> {
+    let start = Instant::now();
+    let mut counters = SearchCounters::default();
+    let result = run_canonical_search(tensor, bsgs, &mut counters);
+    let search_nanos = start.elapsed().as_nanos() as u64;
+
+    let pruned = record_search_globals(&counters, search_nanos);
+
+    let stats = CanonicalizeStats {
+        group_order: bsgs.order(),
+        generators: bsgs.generators.len(),
+        candidates_visited: counters.visited,
+        candidates_pruned: pruned,
+        allocations: counters.allocations,
+        prepare_nanos: 0,
+        search_nanos,
+        used_enumeration: counters.used_enumeration,
+    };
+    result.map(|tensor| (tensor, stats))
+}
+
+/// Folds one search's counters into the process-wide totals, returning the
+/// pruned-candidate count
+fn record_search_globals(counters: &SearchCounters, search_nanos: u64) -> u64 {
+    CALLS.fetch_add(1, Ordering::Relaxed);
+    CANDIDATES_VISITED.fetch_add(counters.visited, Ordering::Relaxed);
+    let pruned = counters.visited.saturating_sub(counters.kept);
+    CANDIDATES_PRUNED.fetch_add(pruned, Ordering::Relaxed);
+    SEARCH_NANOS.fetch_add(search_nanos, Ordering::Relaxed);
+    if counters.used_enumeration {
+        ENUMERATION_FALLBACKS.fetch_add(1, Ordering::Relaxed);
+    }
+    pruned
+}
+
+/// The canonical search proper: zero detection, chain descent, scoring, and
+/// the enumeration fallback
+fn run_canonical_search(
+    tensor: &Tensor,
+    bsgs: &BSGS,
+    counters: &mut SearchCounters,
+) -> Result<Tensor> {
+    if let Some((perm, _)) = canonical_permutation(tensor, bsgs, counters)? {
+        tensor.permute(&perm)
+    } else {
+        let mut zero_tensor = tensor.clone();
+        zero_tensor.set_coefficient(0);
+        Ok(zero_tensor)
+    }
+}
+
+/// Finds the winning group element without materializing any tensor:
+/// returns the permutation producing the canonical arrangement together
+/// with the canonical coefficient, or `None` when the tensor vanishes
+fn canonical_permutation(
+    tensor: &Tensor,
+    bsgs: &BSGS,
+    counters: &mut SearchCounters,
+) -> Result<Option<(Permutation, Coefficient)>> {
+    // One-shot zero detection: the tensor vanishes iff some group element
+    // fixes the index arrangement with sign -1. Deciding this once against
+    // the stabilizer chain replaces the per-candidate symmetry scans below.
+    if arrangement_vanishes(tensor, bsgs) {
+        return Ok(None);
+    }
+
+    // Walk the stabilizer chain base point by base point, keeping only the
+    // coset representatives that realize the minimal index at each slot.
+    // This finds the minimal representative in O(levels * |orbit|) work
+    // without materializing the group.
+    let minimal = minimal_representatives(tensor, bsgs, counters);
+
+    // Score the representatives; only the winner is materialized as a full
+    // tensor. For Symmetric/Antisymmetric/SymmetricPairs symmetries the
+    // sign map is a homomorphism, so the sign carried through the chain is
+    // exact and no symmetry re-scan is needed per candidate. Cyclic and
+    // Custom symmetries assign sign zero to elements outside their listed
+    // subsets, so their candidates are rescored against the symmetries.
+    let exact_signs = !tensor.symmetries().iter().any(|s| {
+        matches!(
+            s,
+            Symmetry::Cyclic { .. } | Symmetry::Custom { .. } | Symmetry::CustomPacked { .. }
+        )
+    });
+
+    let mut best: Option<(Coefficient, &Permutation)> = None;
+    if exact_signs {
+        for (perm, sign) in &minimal {
+            let coefficient = tensor.coefficient() * *sign;
+            match &best {
+                Some((best_coefficient, _)) if coefficient >= *best_coefficient => {}
+                _ => best = Some((coefficient, perm)),
+            }
+        }
+    } else {
+        let mut scratch = Candidate::new();
+        for (perm, _) in &minimal {
+            tensor.permute_into(perm, &mut scratch)?;
+            if scratch.coefficient().is_zero() {
+                continue;
+            }
+            match &best {
+                Some((best_coefficient, _)) if scratch.coefficient() >= *best_coefficient => {}
+                _ => best = Some((scratch.coefficient(), perm)),
+            }
+        }
+    }
+
+    if let Some((coefficient, perm)) = best {
+        return Ok(Some((perm.clone(), coefficient)));
+    }
+
+    // Every minimal representative had sign zero under some symmetry
+    // (possible for Cyclic/Custom symmetries that only admit a subset of the
+    // generated group). Fall back to the exhaustive search over the group.
+    counters.used_enumeration = true;
+    enumeration_permutation(tensor, bsgs, counters)
+}
+
+/// Finds the group elements producing the lexicographically minimal index
+/// arrangement by descending the stabilizer chain.
+///
+/// At each level the search extends every surviving coset representative by
+/// the transversal elements of that level, pruning all extensions whose index
+/// at the level's slot is not minimal. The returned permutations all yield
+/// the same (minimal) index arrangement; they may differ in sign, which is
+/// composed through the chain and returned alongside each element.
+fn minimal_representatives(
+    tensor: &Tensor,
+    bsgs: &BSGS,
+    counters: &mut SearchCounters,
+) -> Vec<(Permutation, i32)> {
+    if let Some(reps) = minimal_representatives_small(tensor, bsgs, counters) {
+        return reps;
+    }
+    minimal_representatives_general(tensor, bsgs, counters)
+}
+
+/// Descent specialized to degrees that fit the inline `SmallPerm`
+/// representation: the frontier is held and composed entirely in registers,
+/// with no per-candidate allocation. Returns `None` when the rank exceeds
+/// the inline capacity.
+fn minimal_representatives_small(
+    tensor: &Tensor,
+    bsgs: &BSGS,
+    counters: &mut SearchCounters,
+) -> Option<Vec<(Permutation, i32)>> {
+    let identity = SmallPerm::identity(tensor.rank())?;
+    let indices = tensor.indices();
+
+    let mut frontier: Vec<(SmallPerm, i32)> = vec![(identity, 1)];
+    for level in &bsgs.levels {
+        let mut best: Option<&TensorIndex> = None;
+        let mut survivors: Vec<(usize, usize)> = Vec::new(); // (frontier idx, orbit point)
+
+        for (fi, (partial, _)) in frontier.iter().enumerate() {
+            for &y in &level.orbit {
+                counters.visited += 1;
+                let candidate = &indices[partial.apply(y)];
+                if let Some(current) = best {
+                    match slot_key_cmp(candidate, current) {
+                        std::cmp::Ordering::Less => {
+                            best = Some(candidate);
+                            survivors.clear();
+                            survivors.push((fi, y));
+                        }
+                        std::cmp::Ordering::Equal => survivors.push((fi, y)),
+                        std::cmp::Ordering::Greater => {}
+                    }
+                } else {
+                    best = Some(candidate);
+                    survivors.push((fi, y));
+                }
+            }
+        }
+
+        let mut next_frontier: Vec<(SmallPerm, i32)> = Vec::with_capacity(survivors.len());
+        for (fi, y) in survivors {
+            let u_y = level.transversal[y].as_ref()?;
+            let (partial, sign) = &frontier[fi];
+            let extended = SmallPerm::from_slice(&u_y.perm)?.compose(partial);
+            if !next_frontier.iter().any(|(p, _)| *p == extended) {
+                next_frontier.push((extended, sign * u_y.sign));
+                counters.kept += 1;
+            }
+        }
+        frontier = next_frontier;
+    }
+    Some(
+        frontier
+            .iter()
+            .map(|(p, sign)| (p.to_vec(), *sign))
+            .collect(),
+    )
+}
+
+/// General descent on array-form permutations, for ranks beyond the inline
+/// capacity of `SmallPerm`
+fn minimal_representatives_general(
+    tensor: &Tensor,
+    bsgs: &BSGS,
+    counters: &mut SearchCounters,
+) -> Vec<(Permutation, i32)> {
+    let n = tensor.rank();
+    let indices = tensor.indices();
+
+    let mut frontier: Vec<(Permutation, i32)> = vec![((0..n).collect(), 1)];
+    for level in &bsgs.levels {
+        let mut best: Option<&TensorIndex> = None;
+        let mut survivors: Vec<(usize, usize)> = Vec::new(); // (frontier idx, orbit point)
+
+        for (fi, (partial, _)) in frontier.iter().enumerate() {
+            for &y in &level.orbit {
+                counters.visited += 1;
+                let candidate = &indices[partial[y]];
+                if let Some(current) = best {
+                    match slot_key_cmp(candidate, current) {
+                        std::cmp::Ordering::Less => {
+                            best = Some(candidate);
+                            survivors.clear();
+                            survivors.push((fi, y));
+                        }
+                        std::cmp::Ordering::Equal => survivors.push((fi, y)),
+                        std::cmp::Ordering::Greater => {}
+                    }
+                } else {
+                    best = Some(candidate);
+                    survivors.push((fi, y));
+                }
+            }
+        }
+
+        let mut next_frontier: Vec<(Permutation, i32)> = Vec::with_capacity(survivors.len());
+        for (fi, y) in survivors {
+            if let Some(u_y) = level.transversal[y].as_ref() {
+                let (partial, sign) = &frontier[fi];
+                let extended = crate::schreier_sims::compose_permutations(&u_y.perm, partial);
+                counters.allocations += 1;
+                if !next_frontier.iter().any(|(p, _)| *p == extended) {
+                    next_frontier.push((extended, sign * u_y.sign));
+                    counters.kept += 1;
+                }
+            }
+        }
+        frontier = next_frontier;
+    }
+    frontier
+}
+
+/// Decides whether the tensor vanishes identically: true iff some group
+/// element fixes the index arrangement (slot by slot, by name and variance)
+/// with sign -1.
+///
+/// The stabilizer of the arrangement is walked with the same chain descent
+/// as the minimal search, but keeping only extensions that reproduce the
+/// original index at each base point. The surviving elements are exactly
+/// the arrangement-stabilizers; a negative sign among them collapses every
+/// representative pairwise and the tensor is zero.
+fn arrangement_vanishes(tensor: &Tensor, bsgs: &BSGS) -> bool {
+    let n = tensor.rank();
+    let indices = tensor.indices();
+
+    let mut frontier: Vec<Permutation> = vec![(0..n).collect()];
+    for level in &bsgs.levels {
+        let mut next_frontier: Vec<Permutation> = Vec::with_capacity(frontier.len());
+        for partial in &frontier {
+            for &y in &level.orbit {
+                let candidate = &indices[partial[y]];
+                if slot_key_cmp(candidate, &indices[level.point]) != std::cmp::Ordering::Equal {
+                    continue;
+                }
+                if let Some(u_y) = level.transversal[y].as_ref() {
+                    let extended = crate::schreier_sims::compose_permutations(&u_y.perm, partial);
+                    if !next_frontier.contains(&extended) {
+                        next_frontier.push(extended);
+                    }
+                }
+            }
         }
+        frontier = next_frontier;
     }
 
-    // Generate all valid permutations considering symmetries
-    let valid_permutations = generate_valid_permutations(tensor);
+    frontier.iter().any(|g| {
+        let sign: i32 = tensor
+            .symmetries()
+            .iter()
+            .map(|s| s.permutation_sign(g))
+            .product();
+        sign < 0
+    })
+}
+
+/// Compares two indices exactly as `tensor_canonical_key` orders them within
+/// a slot: the name bytes followed by the variance marker ('^' sorts before
+/// '_', so contravariant indices come first) and the slot separator.
+fn slot_key_cmp(a: &TensorIndex, b: &TensorIndex) -> std::cmp::Ordering {
+    let marker = |idx: &TensorIndex| if idx.is_contravariant() { b'^' } else { b'_' };
+    a.name()
+        .bytes()
+        .chain([marker(a), b'|'])
+        .cmp(b.name().bytes().chain([marker(b), b'|']))
+}
+
+/// Exhaustive fallback: materializes the symmetry group and scans every
+/// candidate, as the original algorithm did. Only used when the chain
+/// descent cannot decide (all minimal representatives have sign zero).
+/// Yields the winning permutation and coefficient, or `None` when every
+/// candidate vanishes; no tensor is built.
+fn enumeration_permutation(
+    tensor: &Tensor,
+    bsgs: &BSGS,
+    counters: &mut SearchCounters,
+) -> Result<Option<(Permutation, Coefficient)>> {
+    let mut valid_permutations = enumerate_group(bsgs, tensor.rank());
+    counters.visited += valid_permutations.len() as u64;
+    counters.allocations += valid_permutations.len() as u64;
 
     if valid_permutations.is_empty() {
-        return Ok(tensor.clone());
+        return Ok(Some(((0..tensor.rank()).collect(), tensor.coefficient())));
+    }
+
+    if let Some(ranks) = SlotRanks::build(tensor) {
+        // The scan scores candidates by sign alone; the winner's exact
+        // coefficient is reconstructed from the base coefficient here
+        let base_sign = tensor.coefficient().signum();
+        return Ok(
+            packed_enumeration_best(tensor, &valid_permutations, &ranks).map(
+                |(_, score, position)| {
+                    let coefficient = tensor.coefficient() * (score * base_sign);
+                    (valid_permutations.swap_remove(position), coefficient)
+                },
+            ),
+        );
     }
 
     // Find lexicographically minimal tensor form
-    let mut best_tensor = None;
-    let mut best_canonical_key = None;
+    let mut best: Option<(String, usize, Coefficient)> = None;
 
-    for perm in valid_permutations {
-        let candidate = tensor.permute(&perm)?;
+    for (position, perm) in valid_permutations.iter().enumerate() {
+        let candidate = tensor.permute(perm)?;
 
         if candidate.is_zero() {
             continue;
         }
 
         let canonical_key = tensor_canonical_key(&candidate);
+        let better = match &best {
+            Some((best_key, _, _)) => canonical_key < *best_key,
+            None => true,
+        };
+        if better {
+            best = Some((canonical_key, position, candidate.coefficient()));
+        }
+    }
+
+    Ok(best
+        .map(|(_, position, coefficient)| (valid_permutations.swap_remove(position), coefficient)))
+}
+
+/// Per-call rank table for packed candidate comparison
+///
+/// Every candidate is a permutation of the same index multiset, so each
+/// original slot can be assigned once the rank of its index in the slot
+/// ordering (equal indices share a rank). A candidate's key then packs the
+/// ranks of its permuted slots into a `u64`, ordered identically to the
+/// string key of `tensor_canonical_key` but compared as one integer (and
+/// small enough that the parallel scan can publish its best key through a
+/// single atomic word).
+struct SlotRanks {
+    /// Rank of each original slot's index under `slot_key_cmp`
+    ranks: [u8; 16],
+    /// Rank of each original slot's index by name only (for zero detection)
+    name_ranks: [u8; 16],
+}
 
-        if let Some(ref best_key) = best_canonical_key {
-            if canonical_key < *best_key {
-                best_canonical_key = Some(canonical_key);
-                best_tensor = Some(candidate);
+impl SlotRanks {
+    /// Builds the table, or `None` when the rank exceeds the packed capacity
+    fn build(tensor: &Tensor) -> Option<Self> {
+        let indices = tensor.indices();
+        let n = indices.len();
+        if n > 16 {
+            return None;
+        }
+
+        let mut order: Vec<usize> = (0..n).collect();
+        order.sort_by(|&a, &b| slot_key_cmp(&indices[a], &indices[b]));
+
+        let mut ranks = [0u8; 16];
+        let mut name_ranks = [0u8; 16];
+        let mut rank = 0u8;
+        let mut name_rank = 0u8;
+        for (pos, &slot) in order.iter().enumerate() {
+            if pos > 0 {
+                let prev = order[pos - 1];
+                if slot_key_cmp(&indices[prev], &indices[slot]) != std::cmp::Ordering::Equal {
+                    rank += 1;
+                }
+                if indices[prev].name() != indices[slot].name() {
+                    name_rank += 1;
+                }
             }
-        } else {
-            best_canonical_key = Some(canonical_key);
-            best_tensor = Some(candidate);
+            ranks[slot] = rank;
+            name_ranks[slot] = name_rank;
         }
+        Some(Self { ranks, name_ranks })
     }
 
-    if let Some(tensor) = best_tensor {
-        Ok(tensor)
+    /// Packed key of the arrangement produced by `perm`: 4 bits per slot
+    /// (ranks never exceed 15 for rank-16 tensors), most significant slot
+    /// first
+    fn packed_key(&self, perm: &[usize]) -> u64 {
+        let mut key = 0u64;
+        for &p in perm {
+            key = (key << 4) | u64::from(self.ranks[p]);
+        }
+        key
+    }
+}
+
+/// Minimum number of enumerated candidates before the packed scan is split
+/// across worker threads; below this the per-candidate work (a few tens of
+/// nanoseconds) cannot amortize spawning the pool
+const PARALLEL_SCAN_MIN: usize = 4096;
+
+/// Candidates claimed per cursor fetch in the parallel scan; large enough
+/// to keep cursor traffic negligible, small enough that a worker stuck on
+/// sign-heavy candidates sheds the rest of the space to idle workers
+const PARALLEL_SCAN_CHUNK: usize = 1024;
+
+/// Packed-key scan over the enumerated candidates: signs are computed from
+/// the symmetries directly and no candidate is ever materialized; the
+/// winner comes back as (key, sign score, position), or `None` when every
+/// candidate vanishes. Large coset spaces (rank-10 symmetric blocks and
+/// worse) are scanned in parallel; small ones stay on the calling thread.
+fn packed_enumeration_best(
+    tensor: &Tensor,
+    valid_permutations: &[Permutation],
+    ranks: &SlotRanks,
+) -> Option<(u64, i32, usize)> {
+    let workers = std::thread::available_parallelism()
+        .map(|n| n.get())
+        .unwrap_or(1);
+    if workers > 1 && valid_permutations.len() >= PARALLEL_SCAN_MIN {
+        parallel_packed_scan(tensor, valid_permutations, ranks, workers)
     } else {
-        // All permutations resulted in zero
-        let mut zero_tensor = tensor.clone();
-        zero_tensor.set_coefficient(0);
-        Ok(zero_tensor)
+        let bound = AtomicU64::new(u64::MAX);
+        packed_scan_range(tensor, valid_permutations, ranks, 0, &bound)
     }
 }
 
-/// Generates all valid permutations respecting symmetries using Schreier-Sims BSGS
-fn generate_valid_permutations(tensor: &Tensor) -> Vec<Permutation> {
-    let n = tensor.rank();
-    let generators = tensor_symmetry_generators(tensor);
-    let bsgs = schreier_sims(&generators, n);
-    enumerate_group(&bsgs, n)
+/// Scans a contiguous run of candidates starting at global position `base`,
+/// returning the local best as (packed key, sign score, global position).
+/// The score is the candidate's symmetry sign times the sign of the base
+/// coefficient, which orders candidates exactly as their full coefficients
+/// would while keeping the tuple a plain machine word.
+///
+/// `shared_bound` holds the smallest packed key any scanner has accepted so
+/// far; candidates keyed strictly above it cannot win and are dropped
+/// without the sign tie-break. The same routine serves the single-threaded
+/// scan (with a private bound) and each parallel worker.
+fn packed_scan_range(
+    tensor: &Tensor,
+    perms: &[Permutation],
+    ranks: &SlotRanks,
+    base: usize,
+    shared_bound: &AtomicU64,
+) -> Option<(u64, i32, usize)> {
+    let base_sign = tensor.coefficient().signum();
+    let mut best: Option<(u64, i32, usize)> = None;
+
+    for (offset, perm) in perms.iter().enumerate() {
+        let mut sign = 1;
+        for symmetry in tensor.symmetries() {
+            sign *= symmetry.permutation_sign(perm);
+            if sign == 0 {
+                break;
+            }
+        }
+        if sign == 0 || arrangement_is_zero(tensor, perm, ranks) {
+            continue;
+        }
+
+        let key = ranks.packed_key(perm);
+        if key > shared_bound.load(Ordering::Relaxed) {
+            continue;
+        }
+        let score = base_sign * sign;
+        let better = match best {
+            Some((best_key, best_score, _)) => (key, score) < (best_key, best_score),
+            None => true,
+        };
+        if better {
+            best = Some((key, score, base + offset));
+            shared_bound.fetch_min(key, Ordering::Relaxed);
+        }
+    }
+
+    best
+}
+
+/// Splits the packed scan across worker threads
+///
+/// Chunks of the candidate space are claimed from a shared atomic cursor -
+/// an idle worker always takes the next unclaimed chunk, so skewed sign
+/// work rebalances itself - and the smallest key accepted anywhere is
+/// published through one atomic word, letting every worker prune against
+/// the global frontier rather than only its own. Worker-local bests are
+/// merged after the join; the (key, score, position) order makes the
+/// winner identical to the sequential scan's.
+fn parallel_packed_scan(
+    tensor: &Tensor,
+    valid_permutations: &[Permutation],
+    ranks: &SlotRanks,
+    workers: usize,
+) -> Option<(u64, i32, usize)> {
+    let cursor = std::sync::atomic::AtomicUsize::new(0);
+    let bound = AtomicU64::new(u64::MAX);
+
+    std::thread::scope(|scope| {
+        let mut handles = Vec::with_capacity(workers);
+        for _ in 0..workers {
+            handles.push(scope.spawn(|| {
+                let mut best: Option<(u64, i32, usize)> = None;
+                loop {
+                    let start = cursor.fetch_add(PARALLEL_SCAN_CHUNK, Ordering::Relaxed);
+                    if start >= valid_permutations.len() {
+                        break;
+                    }
+                    let end = (start + PARALLEL_SCAN_CHUNK).min(valid_permutations.len());
+                    let chunk = packed_scan_range(
+                        tensor,
+                        &valid_permutations[start..end],
+                        ranks,
+                        start,
+                        &bound,
+                    );
+                    best = merge_scan_best(best, chunk);
+                }
+                best
+            }));
+        }
+        let mut best = None;
+        for handle in handles {
+            if let Ok(part) = handle.join() {
+                best = merge_scan_best(best, part);
+            }
+        }
+        best
+    })
+}
+
+/// Combines two scan results, keeping the smaller (key, score, position)
+/// triple; the position component makes ties deterministic
+fn merge_scan_best(
+    a: Option<(u64, i32, usize)>,
+    b: Option<(u64, i32, usize)>,
+) -> Option<(u64, i32, usize)> {
+    match (a, b) {
+        (Some(x), Some(y)) => Some(x.min(y)),
+        (x, None) => x,
+        (None, y) => y,
+    }
+}
+
+/// Checks whether the permuted arrangement vanishes because an antisymmetric
+/// group ends up holding two equally named indices (mirrors
+/// `Symmetry::makes_tensor_zero` on the permuted slots, without building the
+/// candidate tensor)
+fn arrangement_is_zero(tensor: &Tensor, perm: &[usize], ranks: &SlotRanks) -> bool {
+    for symmetry in tensor.symmetries() {
+        if let Symmetry::Antisymmetric { indices } = symmetry {
+            for (pos, &i) in indices.iter().enumerate() {
+                for &j in &indices[pos + 1..] {
+                    if i < perm.len()
+                        && j < perm.len()
+                        && ranks.name_ranks[perm[i]] == ranks.name_ranks[perm[j]]
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    false
 }
 
 /// Enumerate all group elements from a BSGS by recursively applying all strong generators to the identity permutation, using a HashSet to avoid duplicates. This efficiently generates the full permutation group defined by the base and strong generating set, and is much faster than brute-force BFS for most practical tensor symmetry groups.
@@ -156,27 +1298,49 @@ fn enumerate_group(bsgs: &BSGS, degree: usize) -> Vec<Permutation> {
         return vec![(0..degree).collect()];
     }
 
-    // Recursive helper to build up group elements
-    fn enumerate_recursive(
-        generators: &[Permutation],
-        current: &[usize],
-        results: &mut Vec<Permutation>,
-        visited: &mut std::collections::HashSet<Vec<usize>>,
-    ) {
-        if !visited.insert(current.to_owned()) {
-            return;
-        }
-        results.push(current.to_owned());
-        for gen in generators {
-            let next = crate::schreier_sims::compose_permutations(current, gen);
-            enumerate_recursive(generators, &next, results, visited);
+    // Inline fast path: walk the group on packed byte permutations over an
+    // iterative worklist. Each visit costs one shuffle, and the visited set
+    // holds packed u64 words (4 bits per entry) rather than heap vectors.
+    // The worklist also removes any stack-depth concern for large groups.
+    if let Some(identity) = SmallPerm::identity(degree) {
+        if let Some(generators) = bsgs
+            .generators
+            .iter()
+            .map(|g| SmallPerm::from_slice(&g.perm))
+            .collect::<Option<Vec<SmallPerm>>>()
+        {
+            let mut results = Vec::new();
+            let mut visited: std::collections::HashSet<u64> = std::collections::HashSet::new();
+            let mut worklist = vec![identity];
+            visited.insert(identity.packed());
+            while let Some(current) = worklist.pop() {
+                results.push(current.to_vec());
+                for gen in &generators {
+                    let next = current.compose(gen);
+                    if visited.insert(next.packed()) {
+                        worklist.push(next);
+                    }
+                }
+            }
+            return results;
         }
     }
 
+    // General path for larger degrees: same worklist on array-form permutations
     let mut results = Vec::new();
-    let mut visited = std::collections::HashSet::new();
+    let mut visited: std::collections::HashSet<Permutation> = std::collections::HashSet::new();
     let identity: Permutation = (0..degree).collect();
-    enumerate_recursive(&bsgs.generators, &identity, &mut results, &mut visited);
+    visited.insert(identity.clone());
+    let mut worklist = vec![identity];
+    while let Some(current) = worklist.pop() {
+        for gen in &bsgs.generators {
+            let next = crate::schreier_sims::compose_permutations(&current, &gen.perm);
+            if visited.insert(next.clone()) {
+                worklist.push(next);
+            }
+        }
+        results.push(current);
+    }
     results
 }
 
@@ -197,30 +1361,31 @@ fn tensor_canonical_key(tensor: &Tensor) -> String {
     key
 }
 
-/// Converts a symmetry to permutation generators
-fn symmetry_to_generators(symmetry: &Symmetry, size: usize) -> Vec<Permutation> {
+/// Converts a symmetry to signed permutation generators
+fn symmetry_to_generators(symmetry: &Symmetry, size: usize) -> Vec<SignedPerm> {
     match symmetry {
         Symmetry::Symmetric { indices } => {
             let mut generators = Vec::new();
-            // For symmetric group, generate adjacent transpositions
+            // For symmetric group, generate adjacent transpositions (sign +1)
             for i in 0..indices.len().saturating_sub(1) {
                 let mut perm: Vec<usize> = (0..size).collect();
                 if indices[i] < size && indices[i + 1] < size {
                     perm.swap(indices[i], indices[i + 1]);
                 }
-                generators.push(perm);
+                generators.push(SignedPerm::positive(perm));
             }
             generators
         }
         Symmetry::Antisymmetric { indices } => {
             let mut generators = Vec::new();
-            // For antisymmetric group, generate adjacent transpositions
+            // For antisymmetric group, generate adjacent transpositions;
+            // each transposition carries sign -1
             for i in 0..indices.len().saturating_sub(1) {
                 let mut perm: Vec<usize> = (0..size).collect();
                 if indices[i] < size && indices[i + 1] < size {
                     perm.swap(indices[i], indices[i + 1]);
                 }
-                generators.push(perm);
+                generators.push(SignedPerm { perm, sign: -1 });
             }
             generators
         }
@@ -232,7 +1397,7 @@ fn symmetry_to_generators(symmetry: &Symmetry, size: usize) -> Vec<Permutation>
                 if i < size && j < size {
                     let mut perm: Vec<usize> = (0..size).collect();
                     perm.swap(i, j);
-                    generators.push(perm);
+                    generators.push(SignedPerm::positive(perm));
                 }
             }
 
@@ -248,13 +1413,14 @@ fn symmetry_to_generators(symmetry: &Symmetry, size: usize) -> Vec<Permutation>
                     perm[j1] = j2;
                     perm[i2] = i1;
                     perm[j2] = j1;
-                    generators.push(perm);
+                    generators.push(SignedPerm::positive(perm));
                 }
             }
 
             generators
         }
         Symmetry::Cyclic { indices } => {
+            // Cyclic permutations carry sign +1 in this crate's model
             if indices.len() > 1 {
                 let mut perm: Vec<usize> = (0..size).collect();
                 // Create cyclic permutation
@@ -265,20 +1431,33 @@ fn symmetry_to_generators(symmetry: &Symmetry, size: usize) -> Vec<Permutation>
                     }
                     perm[indices[indices.len() - 1]] = first;
                 }
-                vec![perm]
+                vec![SignedPerm::positive(perm)]
             } else {
-                vec![(0..size).collect()]
+                vec![SignedPerm::positive((0..size).collect())]
             }
         }
         Symmetry::Custom {
             valid_permutations,
-            signs: _,
-        } => valid_permutations.clone(),
+            signs,
+        } => valid_permutations
+            .iter()
+            .zip(signs)
+            .map(|(perm, &sign)| SignedPerm {
+                perm: perm.clone(),
+                sign,
+            })
+            .collect(),
+        // Decoded straight out of the contiguous word buffer; like the
+        // Custom arm above this runs once per signature (the BSGS cache
+        // keys on the symmetry list), not once per canonicalization
+        Symmetry::CustomPacked { perms } => perms
+            .iter()
+            .map(|(perm, sign)| SignedPerm { perm, sign })
+            .collect(),
     }
 }
 
 /// Checks if a permutation is the identity
-#[allow(dead_code)]
 fn is_identity(perm: &[usize]) -> bool {
     perm.iter().enumerate().all(|(i, &val)| i == val)
 }
@@ -357,7 +1536,8 @@ fn canonicalize_symmetric_tensor(tensor: &Tensor) -> Result<Tensor> {
     let mut indices_with_positions: Vec<(usize, &TensorIndex)> =
         tensor.indices().iter().enumerate().collect();
 
-    indices_with_positions.sort_by(|a, b| a.1.canonical_cmp(b.1));
+    // Sort on the cached integer key instead of comparing names per probe
+    indices_with_positions.sort_unstable_by_key(|(_, idx)| (idx.sort_key(), idx.position()));
 
     let permutation: Vec<usize> = indices_with_positions.iter().map(|(pos, _)| *pos).collect();
     tensor.permute(&permutation)
@@ -373,20 +1553,60 @@ fn canonicalize_antisymmetric_tensor(tensor: &Tensor) -> Result<Tensor> {
     let mut indices_with_positions: Vec<(usize, &TensorIndex)> =
         tensor.indices().iter().enumerate().collect();
 
-    indices_with_positions.sort_by(|a, b| a.1.canonical_cmp(b.1));
+    // Sort on the cached integer key instead of comparing names per probe
+    indices_with_positions.sort_unstable_by_key(|(_, idx)| (idx.sort_key(), idx.position()));
 
     let permutation: Vec<usize> = indices_with_positions.iter().map(|(pos, _)| *pos).collect();
     tensor.permute(&permutation)
 }
 
 /// Converts all tensor symmetries into a flat list of permutation generators
-fn tensor_symmetry_generators(tensor: &Tensor) -> Vec<Permutation> {
+fn tensor_symmetry_generators(tensor: &Tensor) -> Vec<SignedPerm> {
     let n = tensor.rank();
     let mut gens = Vec::new();
     for sym in tensor.symmetries() {
         gens.extend(symmetry_to_generators(sym, n));
     }
-    gens
+    gens.extend(contraction_generators(tensor.contractions(), n));
+    // Overlapping symmetries routinely emit the same transposition twice
+    // (or one expressible through the others); reduce before the chain build
+    crate::schreier_sims::reduce_generators(&gens, n)
+}
+
+/// Generators of the implicit dummy group for contracted slot pairs
+///
+/// Dummy names are arbitrary, so k marked pairs admit 2^k * k! equivalent
+/// arrangements: each pair may be raised/lowered in place, and whole pairs
+/// may be relabeled against each other. Both operations are slot
+/// permutations, so 2k - 1 generators span the group and the BSGS search
+/// minimizes over it without any explicit permutation list.
+fn contraction_generators(contractions: &[(usize, usize)], size: usize) -> Vec<SignedPerm> {
+    let mut generators = Vec::new();
+
+    // Raise/lower exchange within each pair (sign +1, symmetric metric)
+    for &(u, l) in contractions {
+        if u < size && l < size {
+            let mut perm: Vec<usize> = (0..size).collect();
+            perm.swap(u, l);
+            generators.push(SignedPerm::positive(perm));
+        }
+    }
+
+    // Relabeling two dummy names exchanges their pairs' slots wholesale;
+    // adjacent exchanges generate all k! relabelings
+    for pair_idx in 0..contractions.len().saturating_sub(1) {
+        let (u1, l1) = contractions[pair_idx];
+        let (u2, l2) = contractions[pair_idx + 1];
+
+        if u1 < size && l1 < size && u2 < size && l2 < size {
+            let mut perm: Vec<usize> = (0..size).collect();
+            perm.swap(u1, u2);
+            perm.swap(l1, l2);
+            generators.push(SignedPerm::positive(perm));
+        }
+    }
+
+    generators
 }
 
 #[cfg(test)]
@@ -404,6 +1624,108 @@ mod tests {
         assert_eq!(result, tensor);
     }
 
+    #[test]
+    fn test_bsgs_order_by_orbit_stabilizer() {
+        let mut tensor = Tensor::new(
+            "S",
+            vec![
+                TensorIndex::new("a", 0),
+                TensorIndex::new("b", 1),
+                TensorIndex::new("c", 2),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::symmetric(vec![0, 1, 2]));
+        // Full S_3 on three slots
+        assert_eq!(prepare_bsgs(&tensor).order(), 6);
+        assert_eq!(BSGS::new().order(), 1);
+        assert_eq!(BSGS::identity(4).order(), 1);
+    }
+
+    #[test]
+    fn test_canonicalize_with_budget() {
+        let mut tensor = Tensor::new(
+            "S",
+            vec![
+                TensorIndex::new("c", 0),
+                TensorIndex::new("b", 1),
+                TensorIndex::new("a", 2),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::symmetric(vec![0, 1, 2]));
+
+        match canonicalize_with_budget(&tensor, 2) {
+            Err(crate::ButlerPortugalError::SearchBudgetExceeded { predicted, budget }) => {
+                assert_eq!(predicted, 6);
+                assert_eq!(budget, 2);
+            }
+            other => panic!("expected SearchBudgetExceeded, got {other:?}"),
+        }
+
+        let result = match canonicalize_with_budget(&tensor, 6) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize_with_budget failed: {e}"),
+        };
+        assert_eq!(result.indices()[0].name(), "a");
+        assert_eq!(result.indices()[2].name(), "c");
+    }
+
+    #[test]
+    fn test_canonicalize_traced_reports_search_shape() {
+        let mut tensor = Tensor::new(
+            "R",
+            vec![
+                TensorIndex::new("b", 0),
+                TensorIndex::new("a", 1),
+                TensorIndex::new("d", 2),
+                TensorIndex::new("c", 3),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![2, 3]));
+
+        let (result, stats) = match canonicalize_traced(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize_traced failed: {e}"),
+        };
+        let expected = match canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert_eq!(result, expected);
+        assert_eq!(stats.group_order, 4); // two independent transpositions
+        assert!(stats.generators >= 2);
+        assert!(stats.candidates_visited > 0);
+        assert!(stats.candidates_pruned < stats.candidates_visited);
+        assert!(!stats.used_enumeration);
+    }
+
+    #[test]
+    fn test_canonicalize_traced_trivial_is_empty() {
+        let tensor = Tensor::new("T", vec![TensorIndex::new("i", 0)]);
+        let (_, stats) = match canonicalize_traced(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize_traced failed: {e}"),
+        };
+        assert_eq!(stats, CanonicalizeStats::default());
+    }
+
+    #[test]
+    fn test_global_stats_accumulate() {
+        let mut tensor = Tensor::new(
+            "S",
+            vec![TensorIndex::new("b", 0), TensorIndex::new("a", 1)],
+        );
+        tensor.add_symmetry(Symmetry::symmetric(vec![0, 1]));
+
+        let before = global_stats();
+        if let Err(e) = canonicalize(&tensor) {
+            panic!("canonicalize failed: {e}");
+        }
+        let after = global_stats();
+        assert!(after.calls > before.calls);
+        assert!(after.candidates_visited > before.candidates_visited);
+    }
+
     #[test]
     fn test_symmetric_tensor_canonicalization() {
         let mut tensor = Tensor::new(
@@ -464,6 +1786,317 @@ mod tests {
         assert!(!is_identity(&non_identity));
     }
 
+    #[test]
+    fn test_context_caches_bsgs_per_signature() {
+        let ctx = CanonicalizerContext::new();
+
+        let mut first = Tensor::new(
+            "S",
+            vec![TensorIndex::new("b", 0), TensorIndex::new("a", 1)],
+        );
+        first.add_symmetry(Symmetry::symmetric(vec![0, 1]));
+
+        let mut second = Tensor::new(
+            "T",
+            vec![TensorIndex::new("d", 0), TensorIndex::new("c", 1)],
+        );
+        second.add_symmetry(Symmetry::symmetric(vec![0, 1]));
+
+        for tensor in [&first, &second] {
+            let from_ctx = match ctx.canonicalize(tensor) {
+                Ok(val) => val,
+                Err(e) => panic!("context canonicalize failed: {e}"),
+            };
+            let direct = match canonicalize(tensor) {
+                Ok(val) => val,
+                Err(e) => panic!("canonicalize failed: {e}"),
+            };
+            assert_eq!(from_ctx, direct);
+        }
+
+        // Both tensors share one symmetry signature, so one cached group
+        assert_eq!(ctx.cached_signatures(), 1);
+    }
+
+    #[test]
+    fn test_context_memoizes_search_outcomes() {
+        let ctx = CanonicalizerContext::new();
+        let mut tensor = Tensor::new(
+            "R",
+            vec![
+                TensorIndex::new("d", 0),
+                TensorIndex::new("c", 1),
+                TensorIndex::new("b", 2),
+                TensorIndex::new("a", 3),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![2, 3]));
+        tensor.add_symmetry(Symmetry::symmetric_pairs(vec![(0, 1), (2, 3)]));
+
+        let direct = match canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        let first = match ctx.canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("context canonicalize failed: {e}"),
+        };
+        assert_eq!(ctx.cached_results(), 1);
+
+        // The second call replays the memoized permutation; the result must
+        // be indistinguishable from the searched one
+        let second = match ctx.canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("memoized canonicalize failed: {e}"),
+        };
+        assert_eq!(first, direct);
+        assert_eq!(second, direct);
+        assert_eq!(ctx.cached_results(), 1);
+    }
+
+    #[test]
+    fn test_result_cache_capacity_is_bounded() {
+        let ctx = CanonicalizerContext::with_result_cache_capacity(2);
+        for names in [["b", "a"], ["d", "c"], ["f", "e"]] {
+            let mut tensor = Tensor::new(
+                "S",
+                vec![TensorIndex::new(names[0], 0), TensorIndex::new(names[1], 1)],
+            );
+            tensor.add_symmetry(Symmetry::symmetric(vec![0, 1]));
+            let result = match ctx.canonicalize(&tensor) {
+                Ok(val) => val,
+                Err(e) => panic!("context canonicalize failed: {e}"),
+            };
+            assert_eq!(result.indices()[0].name(), names[1]);
+        }
+        assert!(ctx.cached_results() <= 2);
+
+        // Capacity zero disables memoization without affecting results
+        let disabled = CanonicalizerContext::with_result_cache_capacity(0);
+        let mut tensor = Tensor::new(
+            "S",
+            vec![TensorIndex::new("b", 0), TensorIndex::new("a", 1)],
+        );
+        tensor.add_symmetry(Symmetry::symmetric(vec![0, 1]));
+        if let Err(e) = disabled.canonicalize(&tensor) {
+            panic!("context canonicalize failed: {e}");
+        }
+        assert_eq!(disabled.cached_results(), 0);
+    }
+
+    #[test]
+    fn test_batch_matches_sequential() {
+        let mut tensors = Vec::new();
+        for round in 0..20 {
+            let mut riemann = Tensor::new(
+                "R",
+                vec![
+                    TensorIndex::new("d", 0),
+                    TensorIndex::new("c", 1),
+                    TensorIndex::new("b", 2),
+                    TensorIndex::new("a", 3),
+                ],
+            );
+            riemann.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+            riemann.add_symmetry(Symmetry::antisymmetric(vec![2, 3]));
+            riemann.add_symmetry(Symmetry::symmetric_pairs(vec![(0, 1), (2, 3)]));
+            tensors.push(riemann);
+
+            let mut metric = Tensor::new(
+                "g",
+                vec![
+                    TensorIndex::new("nu", round),
+                    TensorIndex::new("mu", round + 1),
+                ],
+            );
+            metric.add_symmetry(Symmetry::symmetric(vec![0, 1]));
+            tensors.push(metric);
+        }
+
+        let batch = canonicalize_batch(&tensors);
+        assert_eq!(batch.len(), tensors.len());
+        for (tensor, result) in tensors.iter().zip(&batch) {
+            let sequential = match canonicalize(tensor) {
+                Ok(val) => val,
+                Err(e) => panic!("canonicalize failed: {e}"),
+            };
+            match result {
+                Ok(parallel) => assert_eq!(*parallel, sequential),
+                Err(e) => panic!("batch canonicalize failed: {e}"),
+            }
+        }
+    }
+
+    #[test]
+    fn test_canonicalize_in_place_matches_canonicalize() {
+        let mut tensor = Tensor::new(
+            "R",
+            vec![
+                TensorIndex::new("d", 0),
+                TensorIndex::new("c", 1),
+                TensorIndex::new("b", 2),
+                TensorIndex::new("a", 3),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![2, 3]));
+        tensor.add_symmetry(Symmetry::symmetric_pairs(vec![(0, 1), (2, 3)]));
+
+        let expected = match canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        if let Err(e) = canonicalize_in_place(&mut tensor) {
+            panic!("canonicalize_in_place failed: {e}");
+        }
+        assert_eq!(tensor, expected);
+
+        // A second pass finds the identity winner and leaves it untouched
+        let canonical = tensor.clone();
+        if let Err(e) = canonicalize_in_place(&mut tensor) {
+            panic!("canonicalize_in_place failed: {e}");
+        }
+        assert_eq!(tensor, canonical);
+    }
+
+    #[test]
+    fn test_canonicalize_in_place_zeroes_vanishing_tensor() {
+        let mut tensor = Tensor::new(
+            "F",
+            vec![TensorIndex::new("a", 0), TensorIndex::new("a", 1)],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+
+        if let Err(e) = canonicalize_in_place(&mut tensor) {
+            panic!("canonicalize_in_place failed: {e}");
+        }
+        assert_eq!(tensor.coefficient(), 0);
+        assert!(tensor.is_zero());
+    }
+
+    #[test]
+    fn test_descent_matches_enumeration_riemann_squared() {
+        // Rank-8 RR monomial: the chain descent must agree with the
+        // exhaustive search over the full group
+        let names = ["h", "g", "f", "e", "d", "c", "b", "a"];
+        let indices: Vec<TensorIndex> = names
+            .iter()
+            .enumerate()
+            .map(|(i, n)| TensorIndex::new(n, i))
+            .collect();
+        let mut tensor = Tensor::new("RR", indices);
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![2, 3]));
+        tensor.add_symmetry(Symmetry::symmetric_pairs(vec![(0, 1), (2, 3)]));
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![4, 5]));
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![6, 7]));
+        tensor.add_symmetry(Symmetry::symmetric_pairs(vec![(4, 5), (6, 7)]));
+
+        let fast = match canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        let slow = match enumeration_permutation(
+            &tensor,
+            &prepare_bsgs(&tensor),
+            &mut SearchCounters::default(),
+        ) {
+            Ok(Some((perm, _))) => match tensor.permute(&perm) {
+                Ok(val) => val,
+                Err(e) => panic!("permute failed: {e}"),
+            },
+            Ok(None) => panic!("enumeration found no candidate"),
+            Err(e) => panic!("enumeration fallback failed: {e}"),
+        };
+        assert_eq!(fast, slow);
+    }
+
+    #[test]
+    fn test_parallel_scan_matches_sequential() {
+        // Rank-8 antisymmetric block: 8! = 40320 candidates, enough to
+        // cross the parallel threshold, with non-trivial signs. The chunked
+        // scan with the shared bound must elect the same winner as the
+        // single-threaded scan.
+        let names = ["h", "g", "f", "e", "d", "c", "b", "a"];
+        let indices: Vec<TensorIndex> = names
+            .iter()
+            .enumerate()
+            .map(|(i, n)| TensorIndex::new(n, i))
+            .collect();
+        let mut tensor = Tensor::new("T", indices);
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1, 2, 3, 4, 5, 6, 7]));
+
+        let bsgs = prepare_bsgs(&tensor);
+        let candidates = enumerate_group(&bsgs, tensor.rank());
+        assert!(candidates.len() >= PARALLEL_SCAN_MIN);
+        let Some(ranks) = SlotRanks::build(&tensor) else {
+            panic!("rank 8 must fit the packed table")
+        };
+
+        let bound = AtomicU64::new(u64::MAX);
+        let sequential = packed_scan_range(&tensor, &candidates, &ranks, 0, &bound);
+        let parallel = parallel_packed_scan(&tensor, &candidates, &ranks, 4);
+        assert_eq!(parallel, sequential);
+
+        // The winner sorts the indices; reversing eight slots is even
+        let Some((_, coefficient, position)) = parallel else {
+            panic!("scan found no candidate")
+        };
+        assert_eq!(coefficient, 1);
+        let canonical = match tensor.permute(&candidates[position]) {
+            Ok(val) => val,
+            Err(e) => panic!("permute failed: {e}"),
+        };
+        assert_eq!(canonical.indices()[0].name(), "a");
+        assert_eq!(canonical.indices()[7].name(), "h");
+    }
+
+    #[test]
+    fn test_packed_key_orders_like_string_key() {
+        // The packed slot-rank key must order arrangements exactly as the
+        // string key does, including the contravariant-before-covariant quirk
+        let tensor = Tensor::new(
+            "T",
+            vec![
+                TensorIndex::new("b", 0),
+                TensorIndex::contravariant("b", 1),
+                TensorIndex::new("a", 2),
+            ],
+        );
+        let Some(ranks) = SlotRanks::build(&tensor) else {
+            panic!("rank 3 must fit the packed table")
+        };
+
+        let perms = [
+            vec![0, 1, 2],
+            vec![0, 2, 1],
+            vec![1, 0, 2],
+            vec![1, 2, 0],
+            vec![2, 0, 1],
+            vec![2, 1, 0],
+        ];
+        for a in &perms {
+            for b in &perms {
+                let string_order = match (tensor.permute(a), tensor.permute(b)) {
+                    (Ok(ta), Ok(tb)) => tensor_canonical_key(&ta)
+                        .split('#')
+                        .next()
+                        .map(str::to_string)
+                        .cmp(
+                            &tensor_canonical_key(&tb)
+                                .split('#')
+                                .next()
+                                .map(str::to_string),
+                        ),
+                    _ => panic!("permute failed"),
+                };
+                let packed_order = ranks.packed_key(a).cmp(&ranks.packed_key(b));
+                assert_eq!(packed_order, string_order, "perms {a:?} vs {b:?}");
+            }
+        }
+    }
+
     #[test]
     fn test_tensor_canonical_key() {
         let tensor = Tensor::new(
@@ -475,4 +2108,77 @@ mod tests {
         assert!(key.contains("a_"));
         assert!(key.contains("b^"));
     }
+
+    #[test]
+    fn test_stabilizer_detects_hidden_zero() {
+        // T_aba with antisymmetric (0,1) and symmetric (1,2): no duplicate
+        // sits in the antisymmetric slots up front, but the group contains
+        // an arrangement-stabilizer of sign -1, so the tensor vanishes
+        let mut tensor = Tensor::new(
+            "T",
+            vec![
+                TensorIndex::new("a", 0),
+                TensorIndex::new("b", 1),
+                TensorIndex::new("a", 2),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+        tensor.add_symmetry(Symmetry::symmetric(vec![1, 2]));
+
+        let result = match canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert_eq!(result.coefficient(), 0);
+    }
+
+    #[test]
+    fn test_dummy_pair_relabeling() {
+        // T^b_b^a_a with both pairs contracted: relabeling the dummy names
+        // moves the 'a' pair to the front without any Custom permutation list
+        let mut tensor = Tensor::new(
+            "T",
+            vec![
+                TensorIndex::contravariant("b", 0),
+                TensorIndex::new("b", 1),
+                TensorIndex::contravariant("a", 2),
+                TensorIndex::new("a", 3),
+            ],
+        );
+        if let Err(e) = tensor.add_contraction(0, 1) {
+            panic!("contraction failed: {e}");
+        }
+        if let Err(e) = tensor.add_contraction(2, 3) {
+            panic!("contraction failed: {e}");
+        }
+
+        let result = match canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        let names: Vec<&str> = result.indices().iter().map(|i| i.name()).collect();
+        assert_eq!(names, vec!["a", "a", "b", "b"]);
+        assert_eq!(result.coefficient(), 1);
+    }
+
+    #[test]
+    fn test_dummy_pair_orientation() {
+        // T_a^a with the pair contracted: the pair exchange orients the
+        // contravariant member first
+        let mut tensor = Tensor::new(
+            "T",
+            vec![TensorIndex::new("a", 0), TensorIndex::contravariant("a", 1)],
+        );
+        if let Err(e) = tensor.add_contraction(1, 0) {
+            panic!("contraction failed: {e}");
+        }
+
+        let result = match canonicalize(&tensor) {
+            Ok(val) => val,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert!(result.indices()[0].is_contravariant());
+        assert!(!result.indices()[1].is_contravariant());
+        assert_eq!(result.coefficient(), 1);
+    }
 }
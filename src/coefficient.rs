@@ -0,0 +1,366 @@
+//! Exact rational tensor coefficients
+//!
+//! [`Coefficient`] tracks a tensor's scalar factor as an exact rational
+//! number. The common case - small integers whose sign flips under
+//! symmetries - stays inline as a numerator/denominator pair of machine
+//! words; arithmetic that overflows the inline range spills to a boxed
+//! 128-bit pair, so ordinary canonicalization never touches the heap.
+//! Normalization by a Young symmetrizer's term count divides exactly
+//! instead of truncating, which removes the need to pre-scale projection
+//! coefficients by n! on the caller's side.
+//!
+//! Every value is kept normalized: the denominator is positive, numerator
+//! and denominator are coprime, and a spilled value that fits the inline
+//! range is demoted, so structural equality and hashing see one canonical
+//! representation per rational.
+
+use std::cmp::Ordering;
+use std::fmt;
+use std::ops::{Add, AddAssign, Mul, MulAssign, Neg};
+
+/// An exact rational scalar with an inline small-integer fast path
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
+pub struct Coefficient(Repr);
+
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
+enum Repr {
+    /// Numerator and positive denominator in machine words, coprime
+    Small { num: i64, den: i64 },
+    /// Spilled wide rational with the same invariants
+    Big(Box<(i128, i128)>),
+}
+
+impl Coefficient {
+    /// An exact integer value
+    pub fn integer(value: i64) -> Self {
+        Self(Repr::Small { num: value, den: 1 })
+    }
+
+    /// An exact ratio, reduced to lowest terms. A zero denominator yields
+    /// zero: the coefficient is a plain scalar with no notion of infinity.
+    pub fn ratio(num: i64, den: i64) -> Self {
+        normalize(i128::from(num), i128::from(den))
+    }
+
+    /// The numerator and positive denominator of the reduced value
+    pub fn parts(&self) -> (i128, i128) {
+        match &self.0 {
+            Repr::Small { num, den } => (i128::from(*num), i128::from(*den)),
+            Repr::Big(pair) => **pair,
+        }
+    }
+
+    /// True when the value is exactly zero
+    pub fn is_zero(&self) -> bool {
+        matches!(self.0, Repr::Small { num: 0, .. })
+    }
+
+    /// True when the value is exactly one
+    pub fn is_one(&self) -> bool {
+        matches!(self.0, Repr::Small { num: 1, den: 1 })
+    }
+
+    /// True when the denominator is one
+    pub fn is_integer(&self) -> bool {
+        self.parts().1 == 1
+    }
+
+    /// The sign of the value: -1, 0, or +1
+    pub fn signum(&self) -> i32 {
+        match &self.0 {
+            Repr::Small { num, .. } => num.signum() as i32,
+            Repr::Big(pair) => pair.0.signum() as i32,
+        }
+    }
+
+    /// The integer part truncated toward zero, clamped to the `i32` range;
+    /// the legacy integer view of the coefficient
+    pub fn to_i32(&self) -> i32 {
+        let (num, den) = self.parts();
+        i32::try_from(num / den).unwrap_or(if num < 0 { i32::MIN } else { i32::MAX })
+    }
+
+    /// Rebuilds a value from wide numerator/denominator parts, reducing as
+    /// needed; used by deserialization
+    pub(crate) fn from_wide(num: i128, den: i128) -> Self {
+        normalize(num, den)
+    }
+}
+
+impl Default for Coefficient {
+    fn default() -> Self {
+        Self::integer(0)
+    }
+}
+
+impl From<i32> for Coefficient {
+    fn from(value: i32) -> Self {
+        Self::integer(i64::from(value))
+    }
+}
+
+impl From<i64> for Coefficient {
+    fn from(value: i64) -> Self {
+        Self::integer(value)
+    }
+}
+
+impl fmt::Display for Coefficient {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        let (num, den) = self.parts();
+        if den == 1 {
+            write!(f, "{num}")
+        } else {
+            write!(f, "{num}/{den}")
+        }
+    }
+}
+
+impl Mul for Coefficient {
+    type Output = Coefficient;
+
+    fn mul(self, rhs: Coefficient) -> Coefficient {
+        let (n1, d1) = self.parts();
+        let (n2, d2) = rhs.parts();
+        // Cross-reduce first so products of already reduced values rarely
+        // overflow even in the wide representation
+        let g1 = gcd(n1.unsigned_abs(), d2.unsigned_abs());
+        let g2 = gcd(n2.unsigned_abs(), d1.unsigned_abs());
+        let (n1, d2) = (n1 / g1 as i128, d2 / g1 as i128);
+        let (n2, d1) = (n2 / g2 as i128, d1 / g2 as i128);
+        match (n1.checked_mul(n2), d1.checked_mul(d2)) {
+            (Some(num), Some(den)) => normalize(num, den),
+            // Beyond 128 bits; unreachable for the magnitudes a rank <= 16
+            // workload can produce, so saturate with the correct sign
+            _ => saturated(n1.signum() * n2.signum()),
+        }
+    }
+}
+
+impl Mul<i32> for Coefficient {
+    type Output = Coefficient;
+
+    fn mul(self, rhs: i32) -> Coefficient {
+        self * Coefficient::from(rhs)
+    }
+}
+
+impl MulAssign<i32> for Coefficient {
+    fn mul_assign(&mut self, rhs: i32) {
+        *self = std::mem::take(self) * rhs;
+    }
+}
+
+impl Add for Coefficient {
+    type Output = Coefficient;
+
+    fn add(self, rhs: Coefficient) -> Coefficient {
+        let (n1, d1) = self.parts();
+        let (n2, d2) = rhs.parts();
+        // Common-denominator sum over lcm(d1, d2)
+        let g = gcd(d1.unsigned_abs(), d2.unsigned_abs()) as i128;
+        let (f1, f2) = (d2 / g, d1 / g);
+        let num = match (n1.checked_mul(f1), n2.checked_mul(f2)) {
+            (Some(a), Some(b)) => a.checked_add(b),
+            _ => None,
+        };
+        match (num, d1.checked_mul(f1)) {
+            (Some(num), Some(den)) => normalize(num, den),
+            // Beyond 128 bits; see `Mul`
+            _ => saturated(if n1.signum() + n2.signum() < 0 { -1 } else { 1 }),
+        }
+    }
+}
+
+impl AddAssign for Coefficient {
+    fn add_assign(&mut self, rhs: Coefficient) {
+        *self = std::mem::take(self) + rhs;
+    }
+}
+
+impl Neg for Coefficient {
+    type Output = Coefficient;
+
+    fn neg(self) -> Coefficient {
+        let (num, den) = self.parts();
+        normalize(-num, den)
+    }
+}
+
+/// Integer comparison so call sites (and tests) can write
+/// `tensor.coefficient() == 1` unchanged
+impl PartialEq<i32> for Coefficient {
+    fn eq(&self, other: &i32) -> bool {
+        matches!(self.0, Repr::Small { num, den: 1 } if num == i64::from(*other))
+    }
+}
+
+impl PartialOrd for Coefficient {
+    fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
+        Some(std::cmp::Ord::cmp(self, other))
+    }
+}
+
+impl Ord for Coefficient {
+    fn cmp(&self, other: &Self) -> Ordering {
+        let (n1, d1) = self.parts();
+        let (n2, d2) = other.parts();
+        match n1.signum().cmp(&n2.signum()) {
+            Ordering::Equal => {}
+            order => return order,
+        }
+        // Equal signs: cross-multiply when it fits, otherwise compare the
+        // continued-fraction expansions exactly
+        match (n1.checked_mul(d2), n2.checked_mul(d1)) {
+            (Some(a), Some(b)) => a.cmp(&b),
+            _ if n1 < 0 => cmp_positive((-n1, d1), (-n2, d2)).reverse(),
+            _ => cmp_positive((n1, d1), (n2, d2)),
+        }
+    }
+}
+
+/// Exact comparison of two positive rationals of unbounded magnitude by
+/// walking their continued-fraction expansions: compare integer parts,
+/// then recurse on the reciprocals of the fractional parts (which flips
+/// the ordering at each step)
+fn cmp_positive(mut a: (i128, i128), mut b: (i128, i128)) -> Ordering {
+    let mut flipped = false;
+    loop {
+        let (qa, ra) = (a.0 / a.1, a.0 % a.1);
+        let (qb, rb) = (b.0 / b.1, b.0 % b.1);
+        let order = match qa.cmp(&qb) {
+            Ordering::Equal => match (ra == 0, rb == 0) {
+                (true, true) => Ordering::Equal,
+                (true, false) => Ordering::Less,
+                (false, true) => Ordering::Greater,
+                (false, false) => {
+                    a = (a.1, ra);
+                    b = (b.1, rb);
+                    flipped = !flipped;
+                    continue;
+                }
+            },
+            order => order,
+        };
+        return if flipped { order.reverse() } else { order };
+    }
+}
+
+/// Reduces a raw numerator/denominator pair to canonical form, demoting to
+/// the inline representation whenever it fits
+fn normalize(num: i128, den: i128) -> Coefficient {
+    if num == 0 || den == 0 {
+        return Coefficient::integer(0);
+    }
+    let (num, den) = if den < 0 { (-num, -den) } else { (num, den) };
+    let g = gcd(num.unsigned_abs(), den.unsigned_abs()) as i128;
+    let (num, den) = (num / g, den / g);
+    match (i64::try_from(num), i64::try_from(den)) {
+        (Ok(num), Ok(den)) => Coefficient(Repr::Small { num, den }),
+        _ => Coefficient(Repr::Big(Box::new((num, den)))),
+    }
+}
+
+/// The value used when arithmetic exceeds 128 bits: the largest exactly
+/// representable magnitude with the given sign
+fn saturated(sign: i128) -> Coefficient {
+    let num = if sign < 0 { i128::MIN + 1 } else { i128::MAX };
+    Coefficient(Repr::Big(Box::new((num, 1))))
+}
+
+/// Greatest common divisor by the binary-free Euclidean algorithm
+fn gcd(mut a: u128, mut b: u128) -> u128 {
+    while b != 0 {
+        let r = a % b;
+        a = b;
+        b = r;
+    }
+    a.max(1)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_ratio_reduces_and_normalizes_sign() {
+        assert_eq!(Coefficient::ratio(2, 4), Coefficient::ratio(1, 2));
+        assert_eq!(Coefficient::ratio(3, -6), Coefficient::ratio(-1, 2));
+        assert_eq!(Coefficient::ratio(-3, -3), Coefficient::integer(1));
+        assert_eq!(Coefficient::ratio(5, 0), Coefficient::integer(0));
+    }
+
+    #[test]
+    fn test_arithmetic_is_exact() {
+        let half = Coefficient::ratio(1, 2);
+        let third = Coefficient::ratio(1, 3);
+        assert_eq!(half.clone() + third.clone(), Coefficient::ratio(5, 6));
+        assert_eq!(half.clone() * third, Coefficient::ratio(1, 6));
+        assert_eq!(-half, Coefficient::ratio(-1, 2));
+    }
+
+    #[test]
+    fn test_overflow_spills_to_wide_representation() {
+        // (2^62)^2 overflows i64 but fits the spilled pair exactly
+        let big = Coefficient::integer(1 << 62);
+        let product = big.clone() * big.clone();
+        assert_eq!(product.parts(), (1i128 << 124, 1));
+        assert!(product > big);
+        // Dividing back down demotes to the inline representation
+        let back = product * Coefficient::ratio(1, 1 << 62);
+        assert_eq!(back, Coefficient::integer(1 << 62));
+    }
+
+    #[test]
+    fn test_ordering_matches_values() {
+        let values = [
+            Coefficient::integer(-2),
+            Coefficient::ratio(-1, 2),
+            Coefficient::integer(0),
+            Coefficient::ratio(1, 3),
+            Coefficient::ratio(1, 2),
+            Coefficient::integer(1),
+        ];
+        for (i, a) in values.iter().enumerate() {
+            for (j, b) in values.iter().enumerate() {
+                assert_eq!(a.cmp(b), i.cmp(&j), "{a} vs {b}");
+            }
+        }
+    }
+
+    #[test]
+    fn test_ordering_survives_cross_multiplication_overflow() {
+        // Consecutive wide integers are coprime, so these stay spilled and
+        // their cross products exceed i128, forcing the continued-fraction
+        // walk; 1 + 1/(max-1) < 1 + 1/(max-3) resolves at odd depth
+        let max = i128::MAX;
+        let a = Coefficient::from_wide(max, max - 1);
+        let b = Coefficient::from_wide(max - 2, max - 3);
+        assert_eq!(a.cmp(&b), Ordering::Less);
+        assert_eq!(b.cmp(&a), Ordering::Greater);
+        assert_eq!(a.cmp(&a.clone()), Ordering::Equal);
+        // The negative mirror reverses the order
+        assert_eq!((-a).cmp(&-b), Ordering::Greater);
+
+        // 2 - 1/(q+1) > 2 - 1/q resolves at even depth
+        let q = max / 2;
+        let c = Coefficient::from_wide(2 * q + 1, q + 1);
+        let d = Coefficient::from_wide(2 * q - 1, q);
+        assert_eq!(c.cmp(&d), Ordering::Greater);
+        assert_eq!(d.cmp(&c), Ordering::Less);
+    }
+
+    #[test]
+    fn test_truncated_integer_view() {
+        assert_eq!(Coefficient::ratio(7, 2).to_i32(), 3);
+        assert_eq!(Coefficient::ratio(-7, 2).to_i32(), -3);
+        assert_eq!(Coefficient::integer(-4).to_i32(), -4);
+        assert_eq!(Coefficient::ratio(1, 3).to_i32(), 0);
+    }
+
+    #[test]
+    fn test_display() {
+        assert_eq!(Coefficient::integer(3).to_string(), "3");
+        assert_eq!(Coefficient::ratio(-1, 2).to_string(), "-1/2");
+    }
+}
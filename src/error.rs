@@ -30,6 +30,9 @@ pub enum ButlerPortugalError {
     /// Mathematical error (division by zero, etc.)
     MathematicalError(String),
 
+    /// Predicted canonicalization search exceeds the caller's budget
+    SearchBudgetExceeded { predicted: u64, budget: u64 },
+
     /// Generic computation error
     ComputationError(String),
 }
@@ -55,6 +58,12 @@ impl fmt::Display for ButlerPortugalError {
             ButlerPortugalError::MathematicalError(msg) => {
                 write!(f, "Mathematical error: {msg}")
             }
+            ButlerPortugalError::SearchBudgetExceeded { predicted, budget } => {
+                write!(
+                    f,
+                    "Search budget exceeded: predicted {predicted} cosets, budget {budget}"
+                )
+            }
             ButlerPortugalError::ComputationError(msg) => {
                 write!(f, "Computation error: {msg}")
             }
@@ -6,8 +6,10 @@
 use std::ffi::{CStr, CString};
 use std::os::raw::c_char;
 use std::ptr;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{mpsc, Arc, Mutex};
 
-use crate::canonicalization::canonicalize;
+use crate::canonicalization::{canonicalize, canonicalize_batch, CanonicalizerContext};
 use crate::index::TensorIndex;
 use crate::symmetry::Symmetry;
 use crate::tensor::Tensor;
@@ -19,6 +21,8 @@ pub type TensorHandle = *mut Tensor;
 pub type TensorIndexHandle = *mut TensorIndex;
 /// Opaque handle to a Symmetry
 pub type SymmetryHandle = *mut Symmetry;
+/// Opaque handle to an Arena
+pub type ArenaHandle = *mut Arena;
 
 /// Result codes for FFI operations
 #[repr(C)]
@@ -96,7 +100,7 @@ pub unsafe extern "C" fn bp_index_clone(index: TensorIndexHandle) -> TensorIndex
     if index.is_null() {
         return ptr::null_mut();
     }
-    Box::into_raw(Box::new((*index).clone()))
+    Box::into_raw(Box::new(*index))
 }
 
 // -----------------------------------------------------------------------------
@@ -245,7 +249,7 @@ pub unsafe extern "C" fn bp_tensor_new(
             if handle.is_null() {
                 return ptr::null_mut();
             }
-            vec.push((*handle).clone());
+            vec.push(*handle);
         }
         vec
     } else {
@@ -284,7 +288,7 @@ pub unsafe extern "C" fn bp_tensor_with_coefficient(
             if handle.is_null() {
                 return ptr::null_mut();
             }
-            vec.push((*handle).clone());
+            vec.push(*handle);
         }
         vec
     } else {
@@ -351,7 +355,10 @@ pub unsafe extern "C" fn bp_tensor_rank(tensor: TensorHandle) -> usize {
     (*tensor).rank()
 }
 
-/// Get the coefficient of a tensor.
+/// Get the coefficient of a tensor, truncated toward zero.
+///
+/// Coefficients are exact rationals internally; the C ABI keeps the
+/// integer view, so a fractional coefficient comes back truncated.
 ///
 /// # Safety
 /// - `tensor` must be a valid non-null handle.
@@ -360,7 +367,7 @@ pub unsafe extern "C" fn bp_tensor_coefficient(tensor: TensorHandle) -> i32 {
     if tensor.is_null() {
         return 0;
     }
-    (*tensor).coefficient()
+    (*tensor).coefficient().to_i32()
 }
 
 /// Check if a tensor is zero due to symmetry constraints.
@@ -440,6 +447,442 @@ pub unsafe extern "C" fn bp_canonicalize(
     }
 }
 
+// -----------------------------------------------------------------------------
+// Arena and Batch Functions
+// -----------------------------------------------------------------------------
+
+/// A slab arena owning every tensor built or produced through the batch FFI.
+///
+/// Handles returned by `bp_tensor_build` and `bp_canonicalize_batch` point
+/// into the arena and must NOT be passed to `bp_tensor_free`; one
+/// `bp_arena_free` releases everything at once, so hosts building millions
+/// of tensors pay no per-handle free traffic.
+pub struct Arena {
+    // Boxed so handles stay valid when the slab vector reallocates
+    #[allow(clippy::vec_box)]
+    tensors: Vec<Box<Tensor>>,
+}
+
+/// Symmetry kind descriptor for `bp_tensor_build`: symmetric group
+pub const BP_SYM_SYMMETRIC: u32 = 0;
+/// Symmetry kind descriptor for `bp_tensor_build`: antisymmetric group
+pub const BP_SYM_ANTISYMMETRIC: u32 = 1;
+/// Symmetry kind descriptor for `bp_tensor_build`: symmetric pairs
+/// (values are flattened pairs `[a0, b0, a1, b1, ...]`)
+pub const BP_SYM_SYMMETRIC_PAIRS: u32 = 2;
+/// Symmetry kind descriptor for `bp_tensor_build`: cyclic group
+pub const BP_SYM_CYCLIC: u32 = 3;
+
+/// Create a new arena.
+///
+/// # Safety
+/// - The returned handle must be freed with `bp_arena_free`.
+#[no_mangle]
+pub unsafe extern "C" fn bp_arena_new() -> ArenaHandle {
+    Box::into_raw(Box::new(Arena {
+        tensors: Vec::new(),
+    }))
+}
+
+/// Free an arena and every tensor it owns.
+///
+/// All tensor handles obtained from this arena are invalidated.
+///
+/// # Safety
+/// - `arena` must be a valid handle returned by `bp_arena_new`, or null
+///   (in which case this is a no-op).
+#[no_mangle]
+pub unsafe extern "C" fn bp_arena_free(arena: ArenaHandle) {
+    if !arena.is_null() {
+        drop(Box::from_raw(arena));
+    }
+}
+
+/// Number of tensors currently owned by the arena.
+///
+/// # Safety
+/// - `arena` must be a valid non-null handle.
+#[no_mangle]
+pub unsafe extern "C" fn bp_arena_len(arena: ArenaHandle) -> usize {
+    if arena.is_null() {
+        return 0;
+    }
+    (*arena).tensors.len()
+}
+
+/// Build a tensor into the arena from flat arrays, with no intermediate
+/// index or symmetry handles.
+///
+/// Index names are passed as one concatenated byte buffer plus a length per
+/// index; `contravariant[i]` is nonzero for contravariant slots. Symmetries
+/// are described by a kind per symmetry (`BP_SYM_*`), a value count per
+/// symmetry, and one flat value array for all of them.
+///
+/// Returns a handle owned by the arena (do NOT free it individually), or
+/// null if any argument is malformed.
+///
+/// # Safety
+/// - `name` must be a valid null-terminated C string.
+/// - `index_names` must hold the concatenation of all index names;
+///   `index_name_lens` must point to `rank` lengths summing to that buffer.
+/// - `contravariant` must point to `rank` flags.
+/// - `sym_kinds` and `sym_value_counts` must point to `num_symmetries`
+///   entries, and `sym_values` to the sum of the counts.
+#[no_mangle]
+#[allow(clippy::too_many_arguments)]
+pub unsafe extern "C" fn bp_tensor_build(
+    arena: ArenaHandle,
+    name: *const c_char,
+    index_names: *const c_char,
+    index_name_lens: *const usize,
+    contravariant: *const u8,
+    rank: usize,
+    coefficient: i32,
+    sym_kinds: *const u32,
+    sym_value_counts: *const usize,
+    sym_values: *const usize,
+    num_symmetries: usize,
+) -> TensorHandle {
+    if arena.is_null() || name.is_null() {
+        return ptr::null_mut();
+    }
+    if rank > 0 && (index_names.is_null() || index_name_lens.is_null() || contravariant.is_null()) {
+        return ptr::null_mut();
+    }
+    if num_symmetries > 0 && (sym_kinds.is_null() || sym_value_counts.is_null()) {
+        return ptr::null_mut();
+    }
+
+    let Ok(name_str) = CStr::from_ptr(name).to_str() else {
+        return ptr::null_mut();
+    };
+
+    // Slice the concatenated name buffer by the per-index lengths
+    let mut indices_vec = Vec::with_capacity(rank);
+    if rank > 0 {
+        let lens = std::slice::from_raw_parts(index_name_lens, rank);
+        let flags = std::slice::from_raw_parts(contravariant, rank);
+        let total: usize = lens.iter().sum();
+        let names = std::slice::from_raw_parts(index_names as *const u8, total);
+        let mut offset = 0;
+        for (position, (&len, &flag)) in lens.iter().zip(flags).enumerate() {
+            let Ok(index_name) = std::str::from_utf8(&names[offset..offset + len]) else {
+                return ptr::null_mut();
+            };
+            indices_vec.push(if flag != 0 {
+                TensorIndex::contravariant(index_name, position)
+            } else {
+                TensorIndex::new(index_name, position)
+            });
+            offset += len;
+        }
+    }
+
+    let mut tensor = Tensor::with_coefficient(name_str, indices_vec, coefficient);
+
+    if num_symmetries > 0 {
+        let kinds = std::slice::from_raw_parts(sym_kinds, num_symmetries);
+        let counts = std::slice::from_raw_parts(sym_value_counts, num_symmetries);
+        let total: usize = counts.iter().sum();
+        if total > 0 && sym_values.is_null() {
+            return ptr::null_mut();
+        }
+        let values = if total > 0 {
+            std::slice::from_raw_parts(sym_values, total)
+        } else {
+            &[]
+        };
+        let mut offset = 0;
+        for (&kind, &count) in kinds.iter().zip(counts) {
+            let slice = &values[offset..offset + count];
+            let symmetry = match kind {
+                BP_SYM_SYMMETRIC => Symmetry::symmetric(slice.to_vec()),
+                BP_SYM_ANTISYMMETRIC => Symmetry::antisymmetric(slice.to_vec()),
+                BP_SYM_SYMMETRIC_PAIRS => {
+                    if count % 2 != 0 {
+                        return ptr::null_mut();
+                    }
+                    Symmetry::symmetric_pairs(slice.chunks(2).map(|c| (c[0], c[1])).collect())
+                }
+                BP_SYM_CYCLIC => Symmetry::cyclic(slice.to_vec()),
+                _ => return ptr::null_mut(),
+            };
+            tensor.add_symmetry(symmetry);
+            offset += count;
+        }
+    }
+
+    let arena = &mut *arena;
+    arena.tensors.push(Box::new(tensor));
+    match arena.tensors.last_mut() {
+        Some(slot) => &mut **slot as TensorHandle,
+        None => ptr::null_mut(),
+    }
+}
+
+/// Canonicalize an array of tensors in parallel, writing one result handle
+/// per input into `results`.
+///
+/// The results are owned by the arena; failed entries are written as null.
+/// Returns `Success` when every tensor canonicalized, `CanonicalizationError`
+/// if any entry failed.
+///
+/// # Safety
+/// - `arena` must be a valid non-null handle.
+/// - `tensors` must point to `count` valid non-null tensor handles.
+/// - `results` must point to writable space for `count` handles.
+#[no_mangle]
+pub unsafe extern "C" fn bp_canonicalize_batch(
+    arena: ArenaHandle,
+    tensors: *const TensorHandle,
+    count: usize,
+    results: *mut TensorHandle,
+) -> BPResult {
+    if arena.is_null() || (count > 0 && (tensors.is_null() || results.is_null())) {
+        return BPResult::NullPointer;
+    }
+
+    let handles = std::slice::from_raw_parts(tensors, count);
+    let mut owned = Vec::with_capacity(count);
+    for &handle in handles {
+        if handle.is_null() {
+            return BPResult::NullPointer;
+        }
+        owned.push((*handle).clone());
+    }
+
+    let outcomes = canonicalize_batch(&owned);
+
+    let arena = &mut *arena;
+    let mut all_ok = true;
+    for (i, outcome) in outcomes.into_iter().enumerate() {
+        let slot = results.add(i);
+        if let Ok(canonical) = outcome {
+            arena.tensors.push(Box::new(canonical));
+            *slot = match arena.tensors.last_mut() {
+                Some(stored) => &mut **stored as TensorHandle,
+                None => ptr::null_mut(),
+            };
+        } else {
+            *slot = ptr::null_mut();
+            all_ok = false;
+        }
+    }
+
+    if all_ok {
+        BPResult::Success
+    } else {
+        BPResult::CanonicalizationError
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Pipelined Queue Functions
+// -----------------------------------------------------------------------------
+
+/// A submission queue feeding an internal worker pool.
+///
+/// A host whose dispatcher thread previously alternated between parsing and
+/// a synchronous `bp_canonicalize` call can instead submit tensors as it
+/// parses them and collect finished results later: submission returns
+/// immediately, the workers run the group searches concurrently through one
+/// shared [`CanonicalizerContext`] (so BSGS construction and memoized
+/// search outcomes are shared across the whole stream), and completions are
+/// delivered in completion order with the caller's tag attached.
+pub struct Queue {
+    /// Job channel; dropped on free so the workers drain and exit
+    sender: Option<mpsc::Sender<(u64, Box<Tensor>)>>,
+    /// Completed results awaiting `bp_queue_drain`
+    ready: ReadyList,
+    /// Jobs submitted but not yet pushed to `ready`
+    in_flight: Arc<AtomicUsize>,
+    workers: Vec<std::thread::JoinHandle<()>>,
+}
+
+/// Opaque handle to a Queue
+pub type QueueHandle = *mut Queue;
+
+/// Completed `(tag, result)` pairs shared between the workers and the drain
+/// call; `None` marks a submission whose canonicalization failed
+type ReadyList = Arc<Mutex<Vec<(u64, Option<Tensor>)>>>;
+
+/// One completed queue entry: the caller's tag and the canonical tensor
+/// (null when canonicalization failed for that submission)
+#[repr(C)]
+pub struct BPQueueItem {
+    pub user_tag: u64,
+    pub tensor: TensorHandle,
+}
+
+impl Queue {
+    fn new(num_threads: usize) -> Self {
+        let workers = if num_threads == 0 {
+            std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1)
+        } else {
+            num_threads
+        };
+
+        let (sender, receiver) = mpsc::channel::<(u64, Box<Tensor>)>();
+        let receiver = Arc::new(Mutex::new(receiver));
+        let context = Arc::new(CanonicalizerContext::new());
+        let ready: ReadyList = Arc::new(Mutex::new(Vec::new()));
+        let in_flight = Arc::new(AtomicUsize::new(0));
+
+        let mut handles = Vec::with_capacity(workers);
+        for _ in 0..workers {
+            let receiver = Arc::clone(&receiver);
+            let context = Arc::clone(&context);
+            let ready = Arc::clone(&ready);
+            let in_flight = Arc::clone(&in_flight);
+            handles.push(std::thread::spawn(move || loop {
+                // Workers take turns receiving; the lock is held only for
+                // the dequeue, never for the search
+                let job = match receiver.lock() {
+                    Ok(receiver) => receiver.recv(),
+                    Err(_) => break,
+                };
+                let Ok((tag, tensor)) = job else {
+                    break; // channel closed: queue is being freed
+                };
+                let result = context.canonicalize(&tensor).ok();
+                if let Ok(mut ready) = ready.lock() {
+                    ready.push((tag, result));
+                }
+                in_flight.fetch_sub(1, Ordering::Relaxed);
+            }));
+        }
+
+        Self {
+            sender: Some(sender),
+            ready,
+            in_flight,
+            workers: handles,
+        }
+    }
+}
+
+impl Drop for Queue {
+    fn drop(&mut self) {
+        // Closing the channel lets every worker finish its current job and
+        // exit; joining makes the free deterministic for the host
+        self.sender = None;
+        for handle in self.workers.drain(..) {
+            let _ = handle.join();
+        }
+    }
+}
+
+/// Create a submission queue backed by `num_threads` worker threads.
+/// Pass zero to use the machine's available parallelism.
+///
+/// # Safety
+/// - The returned handle must be freed with `bp_queue_free`.
+#[no_mangle]
+pub unsafe extern "C" fn bp_queue_new(num_threads: usize) -> QueueHandle {
+    Box::into_raw(Box::new(Queue::new(num_threads)))
+}
+
+/// Free a queue, waiting for already submitted work to finish.
+///
+/// Undrained results are released with the queue.
+///
+/// # Safety
+/// - `queue` must be a valid handle returned by `bp_queue_new`, or null
+///   (in which case this is a no-op).
+#[no_mangle]
+pub unsafe extern "C" fn bp_queue_free(queue: QueueHandle) {
+    if !queue.is_null() {
+        drop(Box::from_raw(queue));
+    }
+}
+
+/// Submit a tensor for canonicalization and return immediately.
+///
+/// Ownership of `tensor` transfers to the queue: the handle is invalid
+/// after a successful submit and must NOT be freed by the caller. The
+/// `user_tag` comes back unchanged with the completed result, so the host
+/// can correlate completions with its own records in any order.
+///
+/// # Safety
+/// - `queue` must be a valid non-null queue handle.
+/// - `tensor` must be a valid non-null handle owned by the caller (not an
+///   arena-owned handle).
+#[no_mangle]
+pub unsafe extern "C" fn bp_queue_submit(
+    queue: QueueHandle,
+    tensor: TensorHandle,
+    user_tag: u64,
+) -> BPResult {
+    if queue.is_null() || tensor.is_null() {
+        return BPResult::NullPointer;
+    }
+    let queue = &*queue;
+    let tensor = Box::from_raw(tensor);
+    let Some(sender) = queue.sender.as_ref() else {
+        return BPResult::InvalidArgument;
+    };
+    queue.in_flight.fetch_add(1, Ordering::Relaxed);
+    if sender.send((user_tag, tensor)).is_err() {
+        queue.in_flight.fetch_sub(1, Ordering::Relaxed);
+        return BPResult::InvalidArgument;
+    }
+    BPResult::Success
+}
+
+/// Collect up to `max` completed results without blocking.
+///
+/// Writes completed `(user_tag, tensor)` pairs into `items` in completion
+/// order and returns how many were written; zero means nothing has
+/// finished yet. Delivered tensor handles are owned by the caller and must
+/// be freed with `bp_tensor_free`; a null tensor marks a submission whose
+/// canonicalization failed.
+///
+/// # Safety
+/// - `queue` must be a valid non-null queue handle.
+/// - `items` must point to writable space for `max` entries.
+#[no_mangle]
+pub unsafe extern "C" fn bp_queue_drain(
+    queue: QueueHandle,
+    items: *mut BPQueueItem,
+    max: usize,
+) -> usize {
+    if queue.is_null() || items.is_null() || max == 0 {
+        return 0;
+    }
+    let Ok(mut ready) = (*queue).ready.lock() else {
+        return 0;
+    };
+    let count = ready.len().min(max);
+    for (i, (tag, result)) in ready.drain(..count).enumerate() {
+        *items.add(i) = BPQueueItem {
+            user_tag: tag,
+            tensor: match result {
+                Some(tensor) => Box::into_raw(Box::new(tensor)),
+                None => ptr::null_mut(),
+            },
+        };
+    }
+    count
+}
+
+/// Number of submissions not yet delivered through `bp_queue_drain`
+/// (queued, running, or completed and waiting). A host can poll this to
+/// decide when a drain loop has caught up with its submissions.
+///
+/// # Safety
+/// - `queue` must be a valid non-null queue handle.
+#[no_mangle]
+pub unsafe extern "C" fn bp_queue_pending(queue: QueueHandle) -> usize {
+    if queue.is_null() {
+        return 0;
+    }
+    let queue = &*queue;
+    let ready = queue.ready.lock().map(|ready| ready.len()).unwrap_or(0);
+    queue.in_flight.load(Ordering::Relaxed) + ready
+}
+
 // -----------------------------------------------------------------------------
 // Version Information
 // -----------------------------------------------------------------------------
@@ -506,6 +949,130 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_ffi_arena_batch_flow() {
+        unsafe {
+            let arena = bp_arena_new();
+            assert!(!arena.is_null());
+
+            // Two antisymmetric rank-2 tensors from flat arrays: "ba" and "ab"
+            let tensor_name = CString::new("F").expect("CString::new failed");
+            let name_lens: [usize; 2] = [1, 1];
+            let covariant_flags: [u8; 2] = [0, 0];
+            let sym_kinds: [u32; 1] = [BP_SYM_ANTISYMMETRIC];
+            let sym_counts: [usize; 1] = [2];
+            let sym_values: [usize; 2] = [0, 1];
+
+            let build = |names: &[u8]| {
+                bp_tensor_build(
+                    arena,
+                    tensor_name.as_ptr(),
+                    names.as_ptr() as *const c_char,
+                    name_lens.as_ptr(),
+                    covariant_flags.as_ptr(),
+                    2,
+                    1,
+                    sym_kinds.as_ptr(),
+                    sym_counts.as_ptr(),
+                    sym_values.as_ptr(),
+                    1,
+                )
+            };
+            let t_ba = build(b"ba");
+            let t_ab = build(b"ab");
+            assert!(!t_ba.is_null());
+            assert!(!t_ab.is_null());
+            assert_eq!(bp_tensor_rank(t_ba), 2);
+            assert_eq!(bp_arena_len(arena), 2);
+
+            let inputs = [t_ba, t_ab];
+            let mut results: [TensorHandle; 2] = [ptr::null_mut(); 2];
+            let status = bp_canonicalize_batch(arena, inputs.as_ptr(), 2, results.as_mut_ptr());
+            assert!(matches!(status, BPResult::Success));
+            assert!(!results[0].is_null());
+            assert!(!results[1].is_null());
+
+            // F_ba canonicalizes to -F_ab
+            assert_eq!(bp_tensor_coefficient(results[0]), -1);
+            assert_eq!(bp_tensor_coefficient(results[1]), 1);
+            assert_eq!(bp_arena_len(arena), 4);
+
+            // One free releases inputs and results alike
+            bp_arena_free(arena);
+        }
+    }
+
+    #[test]
+    fn test_ffi_queue_pipeline() {
+        unsafe {
+            let queue = bp_queue_new(2);
+            assert!(!queue.is_null());
+
+            // Submit F_ba (tag 7) and F_ab (tag 9), both antisymmetric
+            let tensor_name = CString::new("F").expect("CString::new failed");
+            let sym_indices: [usize; 2] = [0, 1];
+            for (tag, names) in [(7u64, ["b", "a"]), (9u64, ["a", "b"])] {
+                let name_0 = CString::new(names[0]).expect("CString::new failed");
+                let name_1 = CString::new(names[1]).expect("CString::new failed");
+                let idx_0 = bp_index_new(name_0.as_ptr(), 0);
+                let idx_1 = bp_index_new(name_1.as_ptr(), 1);
+                let indices = [idx_0, idx_1];
+                let tensor = bp_tensor_new(tensor_name.as_ptr(), indices.as_ptr(), 2);
+                assert!(!tensor.is_null());
+                let symmetry = bp_symmetry_antisymmetric(sym_indices.as_ptr(), 2);
+                let status = bp_tensor_add_symmetry(tensor, symmetry);
+                assert!(matches!(status, BPResult::Success));
+                bp_symmetry_free(symmetry);
+                bp_index_free(idx_0);
+                bp_index_free(idx_1);
+
+                // Ownership of the tensor transfers to the queue
+                let status = bp_queue_submit(queue, tensor, tag);
+                assert!(matches!(status, BPResult::Success));
+            }
+
+            // Poll until both completions arrive (in completion order)
+            let mut collected = Vec::new();
+            while collected.len() < 2 {
+                let mut items: [BPQueueItem; 4] = std::array::from_fn(|_| BPQueueItem {
+                    user_tag: 0,
+                    tensor: ptr::null_mut(),
+                });
+                let delivered = bp_queue_drain(queue, items.as_mut_ptr(), items.len());
+                for item in items.iter().take(delivered) {
+                    collected.push((item.user_tag, item.tensor));
+                }
+                std::thread::yield_now();
+            }
+            assert_eq!(bp_queue_pending(queue), 0);
+
+            // F_ba canonicalizes to -F_ab; F_ab is already canonical
+            collected.sort_by_key(|&(tag, _)| tag);
+            assert_eq!(collected[0].0, 7);
+            assert_eq!(bp_tensor_coefficient(collected[0].1), -1);
+            assert_eq!(collected[1].0, 9);
+            assert_eq!(bp_tensor_coefficient(collected[1].1), 1);
+
+            for (_, tensor) in collected {
+                bp_tensor_free(tensor);
+            }
+            bp_queue_free(queue);
+        }
+    }
+
+    #[test]
+    fn test_ffi_queue_null_safety() {
+        unsafe {
+            assert!(matches!(
+                bp_queue_submit(ptr::null_mut(), ptr::null_mut(), 0),
+                BPResult::NullPointer
+            ));
+            assert_eq!(bp_queue_drain(ptr::null_mut(), ptr::null_mut(), 8), 0);
+            assert_eq!(bp_queue_pending(ptr::null_mut()), 0);
+            bp_queue_free(ptr::null_mut());
+        }
+    }
+
     #[test]
     fn test_ffi_null_safety() {
         unsafe {
@@ -2,14 +2,82 @@
 //!
 //! This module provides the `TensorIndex` struct for representing
 //! individual tensor indices with names and positions.
+//!
+//! Index names are interned in a crate-level symbol table: each distinct
+//! name is stored once and every `TensorIndex` carries a `u32` symbol id
+//! plus a precomputed order key, making the struct `Copy` and index
+//! comparison a pure integer operation. A canonicalization job uses a small,
+//! fixed set of index labels, so the table stays tiny for the life of the
+//! process.
 
+use std::collections::HashMap;
 use std::fmt;
+use std::sync::{OnceLock, RwLock};
+
+/// Crate-level symbol table mapping index names to ids
+struct SymbolTable {
+    ids: HashMap<&'static str, u32>,
+    names: Vec<&'static str>,
+}
+
+fn symbol_table() -> &'static RwLock<SymbolTable> {
+    static SYMBOLS: OnceLock<RwLock<SymbolTable>> = OnceLock::new();
+    SYMBOLS.get_or_init(|| {
+        RwLock::new(SymbolTable {
+            ids: HashMap::new(),
+            names: Vec::new(),
+        })
+    })
+}
+
+/// Interns a name, returning its symbol id and the shared string
+fn intern(name: &str) -> (u32, &'static str) {
+    let table = symbol_table();
+    if let Ok(guard) = table.read() {
+        if let Some(&id) = guard.ids.get(name) {
+            return (id, guard.names[id as usize]);
+        }
+    }
+    match table.write() {
+        Ok(mut guard) => {
+            if let Some(&id) = guard.ids.get(name) {
+                return (id, guard.names[id as usize]);
+            }
+            let leaked: &'static str = Box::leak(name.to_string().into_boxed_str());
+            let id = guard.names.len() as u32;
+            guard.names.push(leaked);
+            guard.ids.insert(leaked, id);
+            (id, leaked)
+        }
+        // Lock poisoned by a panicking thread; leak an uninterned copy so
+        // the index still works (equality falls back to string compare)
+        Err(_) => (u32::MAX, Box::leak(name.to_string().into_boxed_str())),
+    }
+}
+
+/// Packs the first fifteen bytes of the name big-endian into the top bits
+/// and the variance into the low byte (covariant first, matching
+/// `canonical_cmp`), so that one integer comparison resolves the full
+/// name-then-variance order for names up to fifteen bytes. Longer names
+/// tie-break on the full string.
+fn sort_key(name: &str, contravariant: bool) -> u128 {
+    let mut prefix = [0u8; 16];
+    let bytes = name.as_bytes();
+    let len = bytes.len().min(15);
+    prefix[..len].copy_from_slice(&bytes[..len]);
+    prefix[15] = u8::from(contravariant);
+    u128::from_be_bytes(prefix)
+}
 
 /// Represents a single tensor index
-#[derive(Debug, Clone, PartialEq, Eq, Hash)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
 pub struct TensorIndex {
-    /// The name/label of the index (e.g., "mu", "nu", "a", "b")
-    name: String,
+    /// Interned name of the index (e.g., "mu", "nu", "a", "b")
+    name: &'static str,
+    /// Symbol id of the name in the crate-level table
+    symbol: u32,
+    /// Cached sort key: name prefix plus variance, for integer comparison
+    sort_key: u128,
     /// The position of the index in the tensor
     position: usize,
     /// Whether the index is contravariant (true) or covariant (false)
@@ -30,8 +98,11 @@ impl TensorIndex {
     /// let index = TensorIndex::new("mu", 0);
     /// ```
     pub fn new(name: &str, position: usize) -> Self {
+        let (symbol, name) = intern(name);
         Self {
-            name: name.to_string(),
+            name,
+            symbol,
+            sort_key: sort_key(name, false),
             position,
             contravariant: false, // Default to covariant
         }
@@ -43,8 +114,11 @@ impl TensorIndex {
     /// * `name` - The name of the index
     /// * `position` - The position in the tensor
     pub fn contravariant(name: &str, position: usize) -> Self {
+        let (symbol, name) = intern(name);
         Self {
-            name: name.to_string(),
+            name,
+            symbol,
+            sort_key: sort_key(name, true),
             position,
             contravariant: true,
         }
@@ -56,8 +130,11 @@ impl TensorIndex {
     /// * `name` - The name of the index
     /// * `position` - The position in the tensor
     pub fn covariant(name: &str, position: usize) -> Self {
+        let (symbol, name) = intern(name);
         Self {
-            name: name.to_string(),
+            name,
+            symbol,
+            sort_key: sort_key(name, false),
             position,
             contravariant: false,
         }
@@ -65,7 +142,12 @@ impl TensorIndex {
 
     /// Returns the name of the index
     pub fn name(&self) -> &str {
-        &self.name
+        self.name
+    }
+
+    /// Returns the interned symbol id of the index name
+    pub fn symbol(&self) -> u32 {
+        self.symbol
     }
 
     /// Returns the position of the index
@@ -91,12 +173,23 @@ impl TensorIndex {
     /// Sets the variance of the index
     pub fn set_contravariant(&mut self, contravariant: bool) {
         self.contravariant = contravariant;
+        self.sort_key = sort_key(self.name, contravariant);
+    }
+
+    /// Returns the cached sort key: one integer whose ordering matches
+    /// `canonical_cmp` up to position (name first, then variance). Sorting
+    /// on this key avoids any per-comparison work on the index itself.
+    pub fn sort_key(&self) -> u128 {
+        self.sort_key
     }
 
     /// Creates a copy with a new name
     pub fn with_name(&self, name: &str) -> Self {
+        let (symbol, name) = intern(name);
         Self {
-            name: name.to_string(),
+            name,
+            symbol,
+            sort_key: sort_key(name, self.contravariant),
             position: self.position,
             contravariant: self.contravariant,
         }
@@ -104,16 +197,22 @@ impl TensorIndex {
 
     /// Creates a copy with a new position
     pub fn with_position(&self, position: usize) -> Self {
-        Self {
-            name: self.name.clone(),
-            position,
-            contravariant: self.contravariant,
-        }
+        Self { position, ..*self }
     }
 
     /// Checks if two indices can be contracted (same name, different variance)
     pub fn can_contract_with(&self, other: &TensorIndex) -> bool {
-        self.name == other.name && self.contravariant != other.contravariant
+        self.same_name(other) && self.contravariant != other.contravariant
+    }
+
+    /// Checks if two indices share the same name (integer compare for
+    /// interned symbols, string compare otherwise)
+    fn same_name(&self, other: &TensorIndex) -> bool {
+        if self.symbol != u32::MAX && other.symbol != u32::MAX {
+            self.symbol == other.symbol
+        } else {
+            self.name == other.name
+        }
     }
 
     /// Compares indices for canonical ordering
@@ -121,12 +220,15 @@ impl TensorIndex {
     pub fn canonical_cmp(&self, other: &TensorIndex) -> std::cmp::Ordering {
         use std::cmp::Ordering;
 
-        match self.name.cmp(&other.name) {
-            Ordering::Equal => match self.contravariant.cmp(&other.contravariant) {
+        match self.sort_key.cmp(&other.sort_key) {
+            // Equal keys with different names means the names share their
+            // first fifteen bytes; fall back to the full string
+            Ordering::Equal if !self.same_name(other) => match self.name.cmp(other.name) {
                 Ordering::Equal => self.position.cmp(&other.position),
-                other => other,
+                order => order,
             },
-            other => other,
+            Ordering::Equal => self.position.cmp(&other.position),
+            order => order,
         }
     }
 }
@@ -197,6 +299,39 @@ mod tests {
         assert!(index2 < index3); // "a" comes before "b"
     }
 
+    #[test]
+    fn test_interned_symbols() {
+        let first = TensorIndex::new("alpha", 0);
+        let second = TensorIndex::new("alpha", 3);
+        let other = TensorIndex::new("beta", 1);
+
+        // Same name resolves to the same symbol regardless of position
+        assert_eq!(first.symbol(), second.symbol());
+        assert_ne!(first.symbol(), other.symbol());
+    }
+
+    #[test]
+    fn test_order_key_matches_name_order() {
+        // Including names longer than the eight-byte order key
+        let names = [
+            "a",
+            "ab",
+            "b",
+            "mu",
+            "nu",
+            "sigma",
+            "longnamed",
+            "longnamez",
+        ];
+        for x in &names {
+            for y in &names {
+                let ix = TensorIndex::new(x, 0);
+                let iy = TensorIndex::new(y, 0);
+                assert_eq!(ix.canonical_cmp(&iy), x.cmp(y), "{x} vs {y}");
+            }
+        }
+    }
+
     #[test]
     fn test_index_display() {
         let covariant = TensorIndex::covariant("mu", 0);
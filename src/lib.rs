@@ -30,19 +30,30 @@
 //! ```
 
 pub mod canonicalization;
+pub mod coefficient;
 pub mod error;
 pub mod ffi;
 pub mod index;
+pub mod monomial;
+pub mod perm;
 pub mod schreier_sims;
+pub mod serialization;
+pub mod streaming;
 pub mod symmetry;
 pub mod tensor;
 pub mod young_tableaux;
 
-pub use canonicalization::{canonicalize, canonicalize_with_optimizations, CanonicalizationMethod};
+pub use canonicalization::{
+    canonicalize, canonicalize_batch, canonicalize_in_place, canonicalize_traced,
+    canonicalize_with_budget, canonicalize_with_optimizations, global_stats, reset_global_stats,
+    CanonicalizationMethod, CanonicalizeStats, CanonicalizerContext, GlobalStats,
+};
+pub use coefficient::Coefficient;
 pub use error::{ButlerPortugalError, Result};
 pub use index::TensorIndex;
-pub use symmetry::Symmetry;
-pub use tensor::Tensor;
+pub use monomial::{canonicalize_monomial, TensorMonomial};
+pub use symmetry::{PackedPerms, Symmetry};
+pub use tensor::{FixedTensor, Tensor};
 
 #[cfg(test)]
 mod tests {
@@ -0,0 +1,359 @@
+//! Multi-tensor monomial canonicalization
+//!
+//! A product like `R_abcd * R_efgh * T_ij` flattened into one rank-10+
+//! tensor forces the single-group machinery to search the direct product
+//! |G1|·|G2|·|G3| at once. [`TensorMonomial`] keeps the factors separate:
+//! its canonicalizer brings every factor into canonical form independently
+//! (in parallel, through the shared BSGS cache), then minimizes over the
+//! exchange symmetry of identical factors by sorting, so the total work is
+//! the sum of the factor searches instead of their product.
+
+use std::fmt;
+
+use crate::canonicalization::CanonicalizerContext;
+use crate::coefficient::Coefficient;
+use crate::error::Result;
+use crate::tensor::Tensor;
+use crate::ButlerPortugalError;
+
+/// A slot of a monomial: (factor position, index position within the factor)
+pub type FactorSlot = (usize, usize);
+
+/// A commutative product of tensor factors with an overall coefficient and
+/// inter-factor contraction structure
+///
+/// Contractions between the slots of one factor belong on that factor (see
+/// [`Tensor::add_contraction`]); the monomial records only the pairs that
+/// span two factors, and keeps them pointing at the right slots when
+/// canonicalization reorders the factor list.
+#[derive(Debug, Clone, PartialEq)]
+pub struct TensorMonomial {
+    factors: Vec<Tensor>,
+    contractions: Vec<(FactorSlot, FactorSlot)>,
+    coefficient: Coefficient,
+}
+
+impl TensorMonomial {
+    pub fn new(factors: Vec<Tensor>) -> Self {
+        Self {
+            factors,
+            contractions: Vec::new(),
+            coefficient: Coefficient::integer(1),
+        }
+    }
+
+    pub fn factors(&self) -> &[Tensor] {
+        &self.factors
+    }
+
+    pub fn coefficient(&self) -> Coefficient {
+        self.coefficient.clone()
+    }
+
+    pub fn set_coefficient(&mut self, coefficient: impl Into<Coefficient>) {
+        self.coefficient = coefficient.into();
+    }
+
+    /// Contractions spanning two factors, as ((factor, slot), (factor, slot))
+    pub fn contractions(&self) -> &[(FactorSlot, FactorSlot)] {
+        &self.contractions
+    }
+
+    /// Marks two slots of different factors as contracted
+    pub fn add_contraction(&mut self, a: FactorSlot, b: FactorSlot) -> Result<()> {
+        for &(factor, slot) in [&a, &b] {
+            let Some(tensor) = self.factors.get(factor) else {
+                return Err(ButlerPortugalError::IndexOutOfBounds {
+                    index: factor,
+                    max: self.factors.len(),
+                });
+            };
+            if slot >= tensor.rank() {
+                return Err(ButlerPortugalError::IndexOutOfBounds {
+                    index: slot,
+                    max: tensor.rank(),
+                });
+            }
+        }
+        if a.0 == b.0 {
+            return Err(ButlerPortugalError::InvalidTensor(
+                "Contraction within one factor belongs on that factor".to_string(),
+            ));
+        }
+        self.contractions.push((a, b));
+        Ok(())
+    }
+
+    /// True when the product vanishes identically
+    pub fn is_zero(&self) -> bool {
+        self.coefficient.is_zero() || self.factors.iter().any(Tensor::is_zero)
+    }
+
+    /// Canonicalizes the monomial; see
+    /// [`CanonicalizerContext::canonicalize_monomial`]
+    pub fn canonicalize(&self) -> Result<TensorMonomial> {
+        CanonicalizerContext::new().canonicalize_monomial(self)
+    }
+}
+
+impl fmt::Display for TensorMonomial {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        if !self.coefficient.is_one() {
+            write!(f, "{} * ", self.coefficient)?;
+        }
+        for (i, factor) in self.factors.iter().enumerate() {
+            if i > 0 {
+                write!(f, " * ")?;
+            }
+            write!(f, "{factor}")?;
+        }
+        Ok(())
+    }
+}
+
+/// Canonicalizes a monomial factor by factor; see
+/// [`CanonicalizerContext::canonicalize_monomial`]
+pub fn canonicalize_monomial(monomial: &TensorMonomial) -> Result<TensorMonomial> {
+    monomial.canonicalize()
+}
+
+impl CanonicalizerContext {
+    /// Canonicalizes a monomial by exploiting its direct-product structure
+    ///
+    /// Every factor is canonicalized independently through the context's
+    /// batch path (parallel workers, shared BSGS cache), its sign collected
+    /// into the overall coefficient. The factor list is then sorted by
+    /// canonical key, which minimizes over the exchange symmetry of
+    /// identical factors: interchangeable factors land in one fixed order.
+    /// Inter-factor contractions are remapped through the reordering.
+    ///
+    /// The searches never cross factor boundaries, so the candidate count
+    /// is the sum of the per-factor searches rather than the size of the
+    /// product group that a flattened tensor would force.
+    pub fn canonicalize_monomial(&self, monomial: &TensorMonomial) -> Result<TensorMonomial> {
+        let mut coefficient = monomial.coefficient();
+        let mut factors = Vec::with_capacity(monomial.factors().len());
+        for result in self.canonicalize_batch(monomial.factors()) {
+            let mut factor = result?;
+            coefficient = coefficient * factor.coefficient();
+            factor.set_coefficient(1);
+            factors.push(factor);
+        }
+        if coefficient.is_zero() {
+            let mut zero = TensorMonomial::new(factors);
+            zero.contractions = monomial.contractions.clone();
+            zero.coefficient = Coefficient::integer(0);
+            return Ok(zero);
+        }
+
+        // Canonicalization may have permuted each factor's own indices, so
+        // record where every original slot landed before the factor list
+        // itself is reordered
+        let slot_maps: Vec<Vec<usize>> = monomial
+            .factors()
+            .iter()
+            .zip(&factors)
+            .map(|(original, canonical)| slot_map(original, canonical))
+            .collect();
+
+        // Exchange symmetry: identical factors commute, so sorting by
+        // canonical key picks the minimal arrangement. The sort is stable,
+        // so distinct factors with equal keys keep their relative order.
+        let mut order: Vec<usize> = (0..factors.len()).collect();
+        order.sort_by(|&a, &b| factor_key(&factors[a]).cmp(&factor_key(&factors[b])));
+
+        let mut new_position = vec![0usize; factors.len()];
+        for (new, &old) in order.iter().enumerate() {
+            new_position[old] = new;
+        }
+        let mut sorted_factors = Vec::with_capacity(factors.len());
+        for &old in &order {
+            sorted_factors.push(factors[old].clone());
+        }
+
+        let mut contractions: Vec<(FactorSlot, FactorSlot)> = monomial
+            .contractions
+            .iter()
+            .map(|&((fa, sa), (fb, sb))| {
+                let a = (new_position[fa], slot_maps[fa][sa]);
+                let b = (new_position[fb], slot_maps[fb][sb]);
+                if b < a {
+                    (b, a)
+                } else {
+                    (a, b)
+                }
+            })
+            .collect();
+        contractions.sort_unstable();
+
+        Ok(TensorMonomial {
+            factors: sorted_factors,
+            contractions,
+            coefficient,
+        })
+    }
+}
+
+/// Maps each slot of `original` to the slot where its index landed in
+/// `canonical`, matching on index identity (name and variance, the same
+/// identity the slot ordering compares). Duplicate indices are matched in
+/// order, which is harmless because equal indices are interchangeable.
+fn slot_map(original: &Tensor, canonical: &Tensor) -> Vec<usize> {
+    let mut used = vec![false; canonical.rank()];
+    let mut map = Vec::with_capacity(original.rank());
+    for index in original.indices() {
+        let landed = canonical.indices().iter().enumerate().find(|(slot, c)| {
+            !used[*slot]
+                && c.name() == index.name()
+                && c.is_contravariant() == index.is_contravariant()
+        });
+        // Canonicalization only permutes the factor's own indices, so a
+        // match always exists; fall back to the identity slot regardless
+        let slot = landed.map(|(slot, _)| slot).unwrap_or(map.len());
+        if let Some(flag) = used.get_mut(slot) {
+            *flag = true;
+        }
+        map.push(slot);
+    }
+    map
+}
+
+/// Ordering key for factor exchange: the factor name followed by each
+/// index's name and variance marker, mirroring the slot ordering used by
+/// the canonical search
+fn factor_key(tensor: &Tensor) -> Vec<u8> {
+    let mut key = Vec::with_capacity(tensor.name().len() + tensor.rank() * 4);
+    key.extend_from_slice(tensor.name().as_bytes());
+    for index in tensor.indices() {
+        key.push(b'|');
+        key.extend_from_slice(index.name().as_bytes());
+        key.push(if index.is_contravariant() { b'^' } else { b'_' });
+    }
+    key
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::symmetry::Symmetry;
+    use crate::TensorIndex;
+
+    fn antisym_pair(name: &str, first: &str, second: &str) -> Tensor {
+        let mut tensor = Tensor::new(
+            name,
+            vec![TensorIndex::new(first, 0), TensorIndex::new(second, 1)],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+        tensor
+    }
+
+    #[test]
+    fn test_monomial_collects_factor_signs() {
+        // F_{ba} * F_{dc}: each factor flips once, so the signs cancel
+        let monomial = TensorMonomial::new(vec![
+            antisym_pair("F", "b", "a"),
+            antisym_pair("F", "d", "c"),
+        ]);
+        let canonical = match monomial.canonicalize() {
+            Ok(m) => m,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert_eq!(canonical.coefficient(), 1);
+        for factor in canonical.factors() {
+            assert_eq!(factor.coefficient(), 1);
+        }
+        assert_eq!(canonical.factors()[0].indices()[0].name(), "a");
+        assert_eq!(canonical.factors()[1].indices()[0].name(), "c");
+    }
+
+    #[test]
+    fn test_monomial_sorts_identical_factors() {
+        // The same product in either factor order canonicalizes identically
+        let forward = TensorMonomial::new(vec![
+            antisym_pair("F", "a", "b"),
+            antisym_pair("F", "c", "d"),
+        ]);
+        let reversed = TensorMonomial::new(vec![
+            antisym_pair("F", "c", "d"),
+            antisym_pair("F", "a", "b"),
+        ]);
+        let a = match forward.canonicalize() {
+            Ok(m) => m,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        let b = match reversed.canonicalize() {
+            Ok(m) => m,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert_eq!(a, b);
+    }
+
+    #[test]
+    fn test_monomial_zero_factor_zeroes_product() {
+        // F_{aa} vanishes by antisymmetry, so the whole product does
+        let monomial = TensorMonomial::new(vec![
+            antisym_pair("F", "a", "a"),
+            antisym_pair("F", "c", "d"),
+        ]);
+        let canonical = match monomial.canonicalize() {
+            Ok(m) => m,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert_eq!(canonical.coefficient(), 0);
+        assert!(canonical.is_zero());
+    }
+
+    #[test]
+    fn test_monomial_contractions_follow_reordering() {
+        let mut monomial = TensorMonomial::new(vec![
+            antisym_pair("G", "c", "d"),
+            antisym_pair("F", "a", "b"),
+        ]);
+        // Contract G's first slot with F's second slot
+        if let Err(e) = monomial.add_contraction((0, 0), (1, 1)) {
+            panic!("add_contraction failed: {e}");
+        }
+        let canonical = match monomial.canonicalize() {
+            Ok(m) => m,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        // F sorts before G; the contraction must now reference F as factor 0
+        assert_eq!(canonical.factors()[0].name(), "F");
+        assert_eq!(canonical.factors()[1].name(), "G");
+        assert_eq!(canonical.contractions(), &[((0, 1), (1, 0))]);
+    }
+
+    #[test]
+    fn test_monomial_contractions_follow_index_moves() {
+        // G_{dc} canonicalizes to -G_{cd}, moving "d" from slot 0 to slot
+        // 1, so the contraction on "d" must land on the new slot as well
+        // as the reordered factor position
+        let mut monomial = TensorMonomial::new(vec![
+            antisym_pair("G", "d", "c"),
+            antisym_pair("F", "a", "b"),
+        ]);
+        // Contract G's "d" slot with F's "b" slot
+        if let Err(e) = monomial.add_contraction((0, 0), (1, 1)) {
+            panic!("add_contraction failed: {e}");
+        }
+        let canonical = match monomial.canonicalize() {
+            Ok(m) => m,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert_eq!(canonical.coefficient(), -1);
+        assert_eq!(canonical.factors()[0].name(), "F");
+        assert_eq!(canonical.factors()[1].name(), "G");
+        assert_eq!(canonical.contractions(), &[((0, 1), (1, 1))]);
+    }
+
+    #[test]
+    fn test_monomial_rejects_bad_contraction() {
+        let mut monomial = TensorMonomial::new(vec![
+            antisym_pair("F", "a", "b"),
+            antisym_pair("G", "c", "d"),
+        ]);
+        assert!(monomial.add_contraction((0, 0), (2, 0)).is_err()); // no factor 2
+        assert!(monomial.add_contraction((0, 5), (1, 0)).is_err()); // no slot 5
+        assert!(monomial.add_contraction((0, 0), (0, 1)).is_err()); // same factor
+    }
+}
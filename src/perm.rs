@@ -0,0 +1,194 @@
+//! Compact permutation type for small degrees
+//!
+//! This module provides `SmallPerm`, a permutation of degree at most 16
+//! stored inline as bytes. Construction, composition, and inversion touch no
+//! allocator, and composition compiles down to a single byte-shuffle
+//! instruction on targets that support it. The hot loops of the canonical
+//! search and the group walk operate on `SmallPerm`, converting to the
+//! `Vec`-based `Permutation` only at API boundaries.
+
+use crate::canonicalization::Permutation;
+
+/// The largest degree that fits in the inline representation
+pub const MAX_INLINE_DEGREE: usize = 16;
+
+/// A permutation of degree <= 16 with inline byte storage (no heap)
+///
+/// Entries beyond the degree are padded with their own position so that
+/// composition and inversion work uniformly on all 16 lanes.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub struct SmallPerm {
+    entries: [u8; MAX_INLINE_DEGREE],
+    degree: u8,
+}
+
+impl SmallPerm {
+    /// The identity permutation of the given degree, or `None` if the degree
+    /// exceeds the inline capacity
+    pub fn identity(degree: usize) -> Option<Self> {
+        if degree > MAX_INLINE_DEGREE {
+            return None;
+        }
+        let mut entries = [0u8; MAX_INLINE_DEGREE];
+        for (i, e) in entries.iter_mut().enumerate() {
+            *e = i as u8;
+        }
+        Some(Self {
+            entries,
+            degree: degree as u8,
+        })
+    }
+
+    /// Packs an array-form permutation, or `None` if it does not fit
+    pub fn from_slice(perm: &[usize]) -> Option<Self> {
+        if perm.len() > MAX_INLINE_DEGREE {
+            return None;
+        }
+        let mut packed = Self::identity(perm.len())?;
+        for (i, &p) in perm.iter().enumerate() {
+            if p >= perm.len() {
+                return None;
+            }
+            packed.entries[i] = p as u8;
+        }
+        Some(packed)
+    }
+
+    /// The degree of the permutation
+    pub fn degree(&self) -> usize {
+        self.degree as usize
+    }
+
+    /// Image of a point under the permutation
+    #[inline]
+    pub fn apply(&self, point: usize) -> usize {
+        self.entries[point] as usize
+    }
+
+    /// Composes two permutations with the same convention as
+    /// `schreier_sims::compose_permutations`: `result[i] = other[self[i]]`
+    #[inline]
+    pub fn compose(&self, other: &Self) -> Self {
+        Self {
+            entries: shuffle_bytes(&other.entries, &self.entries),
+            degree: self.degree.max(other.degree),
+        }
+    }
+
+    /// The inverse permutation
+    pub fn inverse(&self) -> Self {
+        let mut inv = [0u8; MAX_INLINE_DEGREE];
+        for (i, &p) in self.entries.iter().enumerate() {
+            inv[p as usize] = i as u8;
+        }
+        Self {
+            entries: inv,
+            degree: self.degree,
+        }
+    }
+
+    /// Whether this is the identity permutation
+    pub fn is_identity(&self) -> bool {
+        self.entries
+            .iter()
+            .enumerate()
+            .all(|(i, &p)| p as usize == i)
+    }
+
+    /// Packs the permutation into a single `u64` word, four bits per entry
+    ///
+    /// Entries are all below 16, so the packing is injective for a fixed
+    /// degree; it serves as a compact hash/visited key for group walks.
+    #[inline]
+    pub fn packed(&self) -> u64 {
+        let mut word = 0u64;
+        for &e in self.entries.iter().rev() {
+            word = (word << 4) | u64::from(e);
+        }
+        word
+    }
+
+    /// Unpacks into the array-form `Permutation`
+    pub fn to_vec(&self) -> Permutation {
+        self.entries[..self.degree()]
+            .iter()
+            .map(|&p| p as usize)
+            .collect()
+    }
+}
+
+/// Byte-table lookup: `result[i] = table[indices[i]]`
+///
+/// Uses the SSSE3 byte shuffle when the CPU supports it; all 16 index bytes
+/// are below 16, so the intrinsic's high-bit zeroing never triggers.
+#[inline]
+fn shuffle_bytes(table: &[u8; 16], indices: &[u8; 16]) -> [u8; 16] {
+    #[cfg(target_arch = "x86_64")]
+    {
+        if std::arch::is_x86_feature_detected!("ssse3") {
+            // SAFETY: SSSE3 availability checked above; both inputs are
+            // 16-byte arrays, matching the 128-bit lanes of the intrinsics.
+            unsafe {
+                use std::arch::x86_64::{_mm_loadu_si128, _mm_shuffle_epi8, _mm_storeu_si128};
+                let t = _mm_loadu_si128(table.as_ptr() as *const _);
+                let ix = _mm_loadu_si128(indices.as_ptr() as *const _);
+                let shuffled = _mm_shuffle_epi8(t, ix);
+                let mut out = [0u8; 16];
+                _mm_storeu_si128(out.as_mut_ptr() as *mut _, shuffled);
+                return out;
+            }
+        }
+    }
+    let mut out = [0u8; 16];
+    for (o, &ix) in out.iter_mut().zip(indices.iter()) {
+        *o = table[ix as usize];
+    }
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::schreier_sims::compose_permutations;
+
+    #[test]
+    fn test_identity_and_apply() {
+        let Some(id) = SmallPerm::identity(4) else {
+            panic!("degree 4 must fit inline")
+        };
+        assert!(id.is_identity());
+        assert_eq!(id.apply(2), 2);
+        assert_eq!(id.to_vec(), vec![0, 1, 2, 3]);
+    }
+
+    #[test]
+    fn test_compose_matches_vec_composition() {
+        let p1 = vec![1, 0, 3, 2];
+        let p2 = vec![2, 3, 0, 1];
+        let Some(a) = SmallPerm::from_slice(&p1) else {
+            panic!("p1 must pack")
+        };
+        let Some(b) = SmallPerm::from_slice(&p2) else {
+            panic!("p2 must pack")
+        };
+        assert_eq!(a.compose(&b).to_vec(), compose_permutations(&p1, &p2));
+        assert_eq!(b.compose(&a).to_vec(), compose_permutations(&p2, &p1));
+    }
+
+    #[test]
+    fn test_inverse() {
+        let Some(p) = SmallPerm::from_slice(&[2, 0, 1, 3]) else {
+            panic!("perm must pack")
+        };
+        assert!(p.compose(&p.inverse()).is_identity());
+        assert!(p.inverse().compose(&p).is_identity());
+    }
+
+    #[test]
+    fn test_degree_limit() {
+        let too_big: Vec<usize> = (0..17).collect();
+        assert!(SmallPerm::from_slice(&too_big).is_none());
+        assert!(SmallPerm::identity(17).is_none());
+        assert!(SmallPerm::identity(16).is_some());
+    }
+}
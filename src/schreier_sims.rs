@@ -3,160 +3,253 @@
 //! Implements the Schreier-Sims algorithm for efficiently computing
 //! a base and strong generating set (BSGS) for a permutation group, as well as
 //! the so-called "sift algorithm" for group membership testing and order computation.
+//!
+//! Generators and transversal elements are signed: each carries its +1/-1
+//! sign under the tensor's symmetries, and signs compose multiplicatively
+//! through the chain so the sign of any stored element never has to be
+//! recomputed from the symmetry list.
 
-use crate::canonicalization::{Permutation, BSGS};
+use crate::canonicalization::{Permutation, SignedPerm, BSGS};
+use crate::perm::SmallPerm;
 use std::collections::{HashSet, VecDeque};
 
-/// Computes the orbit of a point under a set of generators
-fn orbit(point: usize, generators: &[Permutation]) -> HashSet<usize> {
-    let mut orbit = HashSet::new();
-    let mut queue = VecDeque::new();
-    orbit.insert(point);
-    queue.push_back(point);
-
-    while let Some(x) = queue.pop_front() {
-        for g in generators {
-            let y = g[x];
-            if orbit.insert(y) {
-                queue.push_back(y);
+/// Reduces a raw generator set before chain construction
+///
+/// Symmetry-to-generator conversion concatenates generators per symmetry
+/// with no global view, so the raw set contains identities, duplicates, and
+/// generators already expressible through the others. This pass drops
+/// identities, dedupes on the packed permutation (falling back to the array
+/// form past the inline capacity), and prunes any generator that sifts to
+/// the identity through a chain built from the generators kept so far.
+/// Every redundant generator removed here shrinks the orbit walks and the
+/// linear strong-generator scans downstream.
+///
+/// Duplicates are resolved by first occurrence, matching how
+/// [`stabilizer_chain`] already treats repeated permutations.
+pub fn reduce_generators(generators: &[SignedPerm], degree: usize) -> Vec<SignedPerm> {
+    let identity: Permutation = (0..degree).collect();
+    let mut seen_packed: HashSet<u64> = HashSet::new();
+    let mut seen_wide: HashSet<Permutation> = HashSet::new();
+    let mut kept: Vec<SignedPerm> = Vec::new();
+
+    for g in generators {
+        if g.perm.len() != degree || g.perm == identity {
+            continue;
+        }
+        let duplicate = match SmallPerm::from_slice(&g.perm) {
+            Some(small) => !seen_packed.insert(small.packed()),
+            None => !seen_wide.insert(g.perm.clone()),
+        };
+        if duplicate {
+            continue;
+        }
+        // Membership sift: a generator reachable from the kept set adds
+        // nothing to the group
+        if !kept.is_empty() {
+            let levels = stabilizer_chain(&kept, degree);
+            if sift_through(&levels, g.clone()).perm == identity {
+                continue;
             }
         }
+        kept.push(g.clone());
     }
-    orbit
+    kept
 }
 
 /// Schreier-Sims algorithm: computes a BSGS for the group generated by `generators`
-pub fn schreier_sims(generators: &[Permutation], degree: usize) -> BSGS {
-    let mut base = Vec::new();
-    let mut strong_gens = generators.to_vec();
-    let mut used_points = HashSet::new();
-
-    // Find a base: pick points moved by the generators
-    for i in 0..degree {
-        if strong_gens.iter().any(|g| g[i] != i) {
-            base.push(i);
-            used_points.insert(i);
-        }
-    }
-    if base.is_empty() {
+///
+/// The returned `BSGS` carries the complete stabilizer chain with
+/// precomputed signed transversals, so membership tests sift against stored
+/// coset representatives instead of rebuilding Schreier trees per call.
+pub fn schreier_sims(generators: &[SignedPerm], degree: usize) -> BSGS {
+    let levels = stabilizer_chain(generators, degree);
+
+    // Strong generators of the whole group live at the first level (it is
+    // the only level whose subgroup fixes no base point)
+    let strong_gens: Vec<SignedPerm> = levels
+        .first()
+        .map(|level| level.gens.clone())
+        .unwrap_or_default();
+
+    if strong_gens.is_empty() {
         // Trivial group
         return BSGS {
             base: vec![],
-            generators: vec![(0..degree).collect()],
+            generators: vec![SignedPerm::positive((0..degree).collect())],
+            levels,
         };
     }
 
-    // Main Schreier-Sims loop
-    let mut i = 0;
-    while i < base.len() {
-        let b = base[i];
-        let orbit_set = orbit(b, &strong_gens);
-        let mut schreier_gens = Vec::new();
-
-        for &alpha in &orbit_set {
-            for g in &strong_gens {
-                let beta = g[alpha];
-                if !orbit_set.contains(&beta) {
-                    // Schreier generator
-                    let mut h = (0..degree).collect::<Vec<_>>();
-                    let tmp = 0..degree;
-                    for j in tmp {
-                        h[j] = g[j];
-                    }
-                    schreier_gens.push(h);
-                }
-            }
-        }
-        for h in schreier_gens {
-            if !strong_gens.contains(&h) {
-                strong_gens.push(h);
-            }
-        }
-        i += 1;
-    }
+    // The base consists of the points with nontrivial orbits
+    let base: Vec<usize> = levels
+        .iter()
+        .filter(|level| level.orbit.len() > 1)
+        .map(|level| level.point)
+        .collect();
 
     BSGS {
         base,
         generators: strong_gens,
+        levels,
     }
 }
 
-/// Sift algorithm for membership testing in a permutation group given by BSGS
-/// Returns true if perm is in the group, false otherwise
-pub fn is_member(perm: &Permutation, bsgs: &BSGS) -> bool {
-    let n = perm.len();
-    let mut h = perm.clone();
-    let id: Permutation = (0..n).collect();
-    let base = &bsgs.base;
-    let strong_gens = &bsgs.generators;
-
-    // For each base point, try to reduce h by right multiplying by a transversal
-    for &beta in base {
-        // Compute the orbit and Schreier tree for this base point
-        let (orbit, schreier_tree) = schreier_orbit_tree(beta, strong_gens, n);
-        let gamma = h[beta];
-        if !orbit.contains(&gamma) {
-            return false; // Not in the orbit, so not in the group
+/// One level of a stabilizer chain: a base point, its orbit under the
+/// level's generators, and signed coset representatives (transversal)
+/// mapping the base point to each orbit point.
+#[derive(Debug, Clone)]
+pub struct ChainLevel {
+    /// The base point fixed by all deeper levels
+    pub point: usize,
+    /// Orbit of `point` under this level's generators, in discovery order
+    pub orbit: Vec<usize>,
+    /// Coset representatives indexed by point: `transversal[y]` maps `point` to `y`
+    pub transversal: Vec<Option<SignedPerm>>,
+    /// Generators of this level's subgroup (they fix all earlier base points)
+    pub gens: Vec<SignedPerm>,
+}
+
+/// Builds a complete stabilizer chain with base `(0, 1, ..., degree - 1)`.
+///
+/// The chain is verified (and extended with missing strong generators) so
+/// that every Schreier generator of each level sifts to the identity through
+/// the deeper levels. A level is kept for every point, including points with
+/// trivial orbits, so callers can walk the chain slot by slot.
+pub fn stabilizer_chain(generators: &[SignedPerm], degree: usize) -> Vec<ChainLevel> {
+    let identity: Permutation = (0..degree).collect();
+    let mut strong_gens: Vec<SignedPerm> = Vec::new();
+    for g in generators {
+        if g.perm.len() == degree
+            && g.perm != identity
+            && !strong_gens.iter().any(|s| s.perm == g.perm)
+        {
+            strong_gens.push(g.clone());
+        }
+    }
+
+    loop {
+        let levels = build_chain_levels(&strong_gens, degree);
+        match find_missing_strong_generator(&levels, &identity) {
+            Some(residue) => strong_gens.push(residue),
+            None => return levels,
         }
-        // Find the word (as a permutation) that maps beta to gamma in the Schreier tree
-        let u_gamma = schreier_coset_representative(beta, gamma, &schreier_tree);
-        // Right multiply h by the inverse of u_gamma
-        let u_gamma_inv = inverse_permutation(&u_gamma);
-        h = compose_permutations(&h, &u_gamma_inv);
     }
-    h == id
 }
 
-/// Compute the orbit of a point and the Schreier tree (parent map)
-fn schreier_orbit_tree(
-    point: usize,
-    generators: &[Permutation],
-    degree: usize,
-) -> (Vec<usize>, Vec<Option<(usize, Permutation)>>) {
-    let mut orbit = Vec::new();
-    let mut schreier_tree = vec![None; degree];
-    let mut visited = vec![false; degree];
-    let mut queue = VecDeque::new();
-    orbit.push(point);
-    visited[point] = true;
-    queue.push_back(point);
-    while let Some(x) = queue.pop_front() {
-        for g in generators {
-            let y = g[x];
-            if !visited[y] {
-                visited[y] = true;
-                orbit.push(y);
-                // Store parent and generator used
-                schreier_tree[y] = Some((x, g.clone()));
-                queue.push_back(y);
+/// Constructs orbit/transversal data for each base point from the current
+/// strong generators, without verifying completeness.
+fn build_chain_levels(strong_gens: &[SignedPerm], degree: usize) -> Vec<ChainLevel> {
+    let mut levels = Vec::with_capacity(degree);
+    for point in 0..degree {
+        // Generators of this level's subgroup: those fixing all earlier base points
+        let gens: Vec<SignedPerm> = strong_gens
+            .iter()
+            .filter(|g| (0..point).all(|b| g.perm[b] == b))
+            .cloned()
+            .collect();
+
+        // BFS orbit with transversal: rep[y] maps `point` to `y`. Visited
+        // tracking is a word-packed bitset, so the membership probe on
+        // every edge of the walk is a single-bit test instead of an
+        // `Option` check against the transversal slot
+        let mut orbit = vec![point];
+        let mut transversal: Vec<Option<SignedPerm>> = vec![None; degree];
+        transversal[point] = Some(SignedPerm::positive((0..degree).collect()));
+        let mut visited = vec![0u64; degree / 64 + 1];
+        visited[point / 64] |= 1 << (point % 64);
+        let mut queue = VecDeque::new();
+        queue.push_back(point);
+        while let Some(x) = queue.pop_front() {
+            let Some(u_x) = transversal[x].clone() else {
+                continue;
+            };
+            for g in &gens {
+                let y = g.perm[x];
+                if visited[y / 64] & (1 << (y % 64)) == 0 {
+                    visited[y / 64] |= 1 << (y % 64);
+                    transversal[y] = Some(compose_signed(&u_x, g));
+                    orbit.push(y);
+                    queue.push_back(y);
+                }
             }
         }
+
+        levels.push(ChainLevel {
+            point,
+            orbit,
+            transversal,
+            gens,
+        });
     }
-    (orbit, schreier_tree)
+    levels
 }
 
-/// Recover the coset representative (as a permutation) from Schreier tree
-fn schreier_coset_representative(
-    root: usize,
-    target: usize,
-    schreier_tree: &[Option<(usize, Permutation)>],
-) -> Permutation {
-    let mut path = Vec::new();
-    let mut current = target;
-    while current != root {
-        if let Some((parent, gen)) = &schreier_tree[current] {
-            path.push(gen.clone());
-            current = *parent;
-        } else {
-            break; // Should not happen if target is in the orbit
+/// Checks every Schreier generator of every level; returns the first sift
+/// residue that is not already represented in the chain, if any.
+fn find_missing_strong_generator(
+    levels: &[ChainLevel],
+    identity: &Permutation,
+) -> Option<SignedPerm> {
+    for (l, level) in levels.iter().enumerate() {
+        for &y in &level.orbit {
+            let Some(u_y) = level.transversal[y].as_ref() else {
+                continue;
+            };
+            for s in &level.gens {
+                let z = s.perm[y];
+                let Some(u_z) = level.transversal[z].as_ref() else {
+                    continue;
+                };
+                // Schreier generator: u_z^{-1} * s * u_y (fixes this base point)
+                let h = compose_signed(&compose_signed(u_y, s), &inverse_signed(u_z));
+                let residue = sift_through(&levels[l + 1..], h);
+                if residue.perm != *identity {
+                    return Some(residue);
+                }
+            }
+        }
+    }
+    None
+}
+
+/// Sifts a signed permutation through the given chain levels, returning the
+/// residue. The residue is the identity exactly when the permutation factors
+/// over the stored transversals.
+fn sift_through(levels: &[ChainLevel], perm: SignedPerm) -> SignedPerm {
+    let mut h = perm;
+    for level in levels {
+        let gamma = h.perm[level.point];
+        match level.transversal[gamma].as_ref() {
+            Some(u_gamma) => {
+                h = compose_signed(&h, &inverse_signed(u_gamma));
+            }
+            None => return h,
         }
     }
-    // Compose the path in reverse order
-    let mut rep: Permutation = (0..schreier_tree.len()).collect();
-    for g in path.iter().rev() {
-        rep = compose_permutations(&rep, g);
+    h
+}
+
+/// Sift algorithm for membership testing in a permutation group given by BSGS
+/// Returns true if perm is in the group, false otherwise
+///
+/// Sifts directly against the transversals stored in the BSGS; no Schreier
+/// trees are rebuilt per call.
+pub fn is_member(perm: &Permutation, bsgs: &BSGS) -> bool {
+    let n = perm.len();
+    let id: Permutation = (0..n).collect();
+    let mut h = perm.clone();
+
+    for level in &bsgs.levels {
+        let gamma = h[level.point];
+        match level.transversal.get(gamma).and_then(|u| u.as_ref()) {
+            Some(u_gamma) => {
+                // Right multiply h by the inverse of the coset representative
+                h = compose_permutations(&h, &inverse_permutation(&u_gamma.perm));
+            }
+            None => return false, // Not in the orbit, so not in the group
+        }
     }
-    rep
+    h == id
 }
 
 /// Compute the inverse of a permutation
@@ -168,6 +261,23 @@ fn inverse_permutation(perm: &Permutation) -> Permutation {
     inv
 }
 
+/// The inverse of a signed permutation; the sign is its own inverse
+fn inverse_signed(sp: &SignedPerm) -> SignedPerm {
+    SignedPerm {
+        perm: inverse_permutation(&sp.perm),
+        sign: sp.sign,
+    }
+}
+
+/// Composes two signed permutations (applies first, then second), signs
+/// multiplying
+pub fn compose_signed(sp1: &SignedPerm, sp2: &SignedPerm) -> SignedPerm {
+    SignedPerm {
+        perm: compose_permutations(&sp1.perm, &sp2.perm),
+        sign: sp1.sign * sp2.sign,
+    }
+}
+
 /// Composes two permutations (applies first, then second)
 pub fn compose_permutations(perm1: &[usize], perm2: &[usize]) -> Permutation {
     let size = perm1.len().max(perm2.len());
@@ -187,18 +297,9 @@ pub fn compose_permutations(perm1: &[usize], perm2: &[usize]) -> Permutation {
 mod tests {
     use super::*;
 
-    #[test]
-    fn test_orbit() {
-        let gens = vec![vec![1, 0, 2]]; // swap 0 and 1
-        let orb = orbit(0, &gens);
-        assert!(orb.contains(&0));
-        assert!(orb.contains(&1));
-        assert!(!orb.contains(&2));
-    }
-
     #[test]
     fn test_schreier_sims_trivial() {
-        let gens: Vec<Permutation> = vec![];
+        let gens: Vec<SignedPerm> = vec![];
         let bsgs = schreier_sims(&gens, 3);
         assert_eq!(bsgs.generators.len(), 1);
         assert_eq!(bsgs.base.len(), 0);
@@ -206,12 +307,56 @@ mod tests {
 
     #[test]
     fn test_schreier_sims_simple() {
-        let gens = vec![vec![1, 0, 2]]; // S_2 on 0,1
+        let gens = vec![SignedPerm::positive(vec![1, 0, 2])]; // S_2 on 0,1
         let bsgs = schreier_sims(&gens, 3);
-        assert!(bsgs.generators.iter().any(|g| g == &vec![1, 0, 2]));
+        assert!(bsgs.generators.iter().any(|g| g.perm == vec![1, 0, 2]));
         assert!(bsgs.base.contains(&0));
     }
 
+    #[test]
+    fn test_signed_transversals_carry_signs() {
+        // One antisymmetric transposition: every non-identity coset
+        // representative built from it must carry sign -1
+        let gens = vec![SignedPerm {
+            perm: vec![1, 0, 2],
+            sign: -1,
+        }];
+        let bsgs = schreier_sims(&gens, 3);
+        let level = &bsgs.levels[0];
+        let Some(u_1) = level.transversal[1].as_ref() else {
+            panic!("point 1 must be in the orbit of 0")
+        };
+        assert_eq!(u_1.perm, vec![1, 0, 2]);
+        assert_eq!(u_1.sign, -1);
+    }
+
+    #[test]
+    fn test_reduce_generators_drops_identity_and_duplicates() {
+        let gens = vec![
+            SignedPerm::positive(vec![0, 1, 2]), // identity
+            SignedPerm::positive(vec![1, 0, 2]),
+            SignedPerm::positive(vec![1, 0, 2]), // duplicate
+        ];
+        let reduced = reduce_generators(&gens, 3);
+        assert_eq!(reduced, vec![SignedPerm::positive(vec![1, 0, 2])]);
+    }
+
+    #[test]
+    fn test_reduce_generators_prunes_generated_elements() {
+        // (0 2) = (0 1)(1 2)(0 1), so the third generator is redundant
+        let gens = vec![
+            SignedPerm::positive(vec![1, 0, 2]),
+            SignedPerm::positive(vec![0, 2, 1]),
+            SignedPerm::positive(vec![2, 1, 0]),
+        ];
+        let reduced = reduce_generators(&gens, 3);
+        assert_eq!(reduced.len(), 2);
+        // The reduced set still generates all of S_3
+        let bsgs = schreier_sims(&reduced, 3);
+        assert!(is_member(&vec![2, 1, 0], &bsgs));
+        assert!(is_member(&vec![1, 2, 0], &bsgs));
+    }
+
     #[test]
     fn test_compose_permutations() {
         let perm1 = vec![1, 0, 2];
@@ -233,7 +378,7 @@ mod tests {
 
     #[test]
     fn test_is_member() {
-        let gens = vec![vec![1, 0, 2]];
+        let gens = vec![SignedPerm::positive(vec![1, 0, 2])];
         let bsgs = schreier_sims(&gens, 3);
         let id = vec![0, 1, 2];
         let swap = vec![1, 0, 2];
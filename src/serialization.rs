@@ -0,0 +1,641 @@
+//! Compact binary serialization for tensors and prepared groups
+//!
+//! Provides a versioned, hand-rolled binary format so a job can snapshot
+//! its canonicalizer state and restore it on startup without re-running
+//! `schreier_sims` for every symmetry signature. Index names are interned
+//! in a header string table and permutations use varint encoding, so the
+//! snapshots stay small. Buffers are plain byte slices, so a restored
+//! process can read them straight out of an mmap.
+//!
+//! The entry points are [`Tensor::to_bytes`]/[`Tensor::from_bytes`],
+//! [`BSGS::to_bytes`]/[`BSGS::from_bytes`], and
+//! [`CanonicalizerContext::snapshot`]/[`CanonicalizerContext::restore`].
+
+use crate::canonicalization::{Permutation, SignedPerm, BSGS};
+use crate::error::Result;
+use crate::schreier_sims::ChainLevel;
+use crate::symmetry::Symmetry;
+use crate::tensor::Tensor;
+use crate::ButlerPortugalError;
+use crate::TensorIndex;
+
+/// Format magic and version for a serialized tensor (version 2: exact
+/// rational coefficient instead of a truncated integer)
+const TENSOR_MAGIC: [u8; 4] = [b'B', b'P', b'T', 2];
+/// Format magic and version for a serialized BSGS
+const BSGS_MAGIC: [u8; 4] = [b'B', b'P', b'G', 1];
+/// Format magic and version for a canonicalizer snapshot
+const SNAPSHOT_MAGIC: [u8; 4] = [b'B', b'P', b'C', 1];
+
+impl Tensor {
+    /// Serializes the tensor into the compact binary format
+    ///
+    /// Index names are deduplicated into a string table, so tensors with
+    /// repeated (dummy) names pay for each name once.
+    pub fn to_bytes(&self) -> Vec<u8> {
+        let mut out = Vec::new();
+        out.extend_from_slice(&TENSOR_MAGIC);
+        write_str(&mut out, self.name());
+
+        // String table: unique index names in first-appearance order
+        let mut table: Vec<&str> = Vec::new();
+        for index in self.indices() {
+            if !table.contains(&index.name()) {
+                table.push(index.name());
+            }
+        }
+        write_varint(&mut out, table.len() as u64);
+        for name in &table {
+            write_str(&mut out, name);
+        }
+
+        write_varint(&mut out, self.indices().len() as u64);
+        for index in self.indices() {
+            let id = table.iter().position(|n| *n == index.name()).unwrap_or(0);
+            write_varint(&mut out, id as u64);
+            out.push(u8::from(index.is_contravariant()));
+            write_varint(&mut out, index.position() as u64);
+        }
+
+        let (num, den) = self.coefficient().parts();
+        write_signed_wide(&mut out, num);
+        write_varint_wide(&mut out, den as u128);
+
+        write_varint(&mut out, self.symmetries().len() as u64);
+        for symmetry in self.symmetries() {
+            write_symmetry(&mut out, symmetry);
+        }
+
+        write_varint(&mut out, self.contractions().len() as u64);
+        for &(u, l) in self.contractions() {
+            write_varint(&mut out, u as u64);
+            write_varint(&mut out, l as u64);
+        }
+
+        out
+    }
+
+    /// Deserializes a tensor written by [`Tensor::to_bytes`]
+    pub fn from_bytes(bytes: &[u8]) -> Result<Self> {
+        let mut reader = Reader::new(bytes);
+        reader.expect_magic(&TENSOR_MAGIC, "tensor")?;
+        let name = reader.read_str()?;
+
+        let table_len = reader.read_varint()? as usize;
+        let mut table = Vec::with_capacity(table_len);
+        for _ in 0..table_len {
+            table.push(reader.read_str()?);
+        }
+
+        let rank = reader.read_varint()? as usize;
+        let mut indices = Vec::with_capacity(rank);
+        for _ in 0..rank {
+            let id = reader.read_varint()? as usize;
+            let index_name = table.get(id).ok_or_else(|| {
+                ButlerPortugalError::InvalidTensor(format!(
+                    "Serialized index references unknown name id {id}"
+                ))
+            })?;
+            let contravariant = reader.read_u8()? != 0;
+            let position = reader.read_varint()? as usize;
+            indices.push(if contravariant {
+                TensorIndex::contravariant(index_name, position)
+            } else {
+                TensorIndex::new(index_name, position)
+            });
+        }
+
+        let num = reader.read_signed_wide()?;
+        let den = reader.read_varint_wide()? as i128;
+        let coefficient = crate::coefficient::Coefficient::from_wide(num, den);
+        let mut tensor = Tensor::with_coefficient(&name, indices, coefficient);
+
+        let num_symmetries = reader.read_varint()? as usize;
+        for _ in 0..num_symmetries {
+            tensor.add_symmetry(read_symmetry(&mut reader)?);
+        }
+
+        let num_contractions = reader.read_varint()? as usize;
+        for _ in 0..num_contractions {
+            let u = reader.read_varint()? as usize;
+            let l = reader.read_varint()? as usize;
+            tensor.add_contraction(u, l)?;
+        }
+
+        Ok(tensor)
+    }
+}
+
+impl BSGS {
+    /// Serializes the prepared group, including the full stabilizer chain
+    /// with its transversals, into the compact binary format
+    pub fn to_bytes(&self) -> Vec<u8> {
+        let mut out = Vec::new();
+        out.extend_from_slice(&BSGS_MAGIC);
+        write_bsgs_body(&mut out, self);
+        out
+    }
+
+    /// Deserializes a group written by [`BSGS::to_bytes`]
+    pub fn from_bytes(bytes: &[u8]) -> Result<Self> {
+        let mut reader = Reader::new(bytes);
+        reader.expect_magic(&BSGS_MAGIC, "BSGS")?;
+        read_bsgs_body(&mut reader)
+    }
+}
+
+/// Writes the BSGS payload without the magic header (shared with snapshots)
+pub(crate) fn write_bsgs_body(out: &mut Vec<u8>, bsgs: &BSGS) {
+    write_varint(out, bsgs.base.len() as u64);
+    for &point in &bsgs.base {
+        write_varint(out, point as u64);
+    }
+
+    write_varint(out, bsgs.generators.len() as u64);
+    for gen in &bsgs.generators {
+        write_signed_perm(out, gen);
+    }
+
+    write_varint(out, bsgs.levels.len() as u64);
+    for level in &bsgs.levels {
+        write_varint(out, level.point as u64);
+        write_varint(out, level.orbit.len() as u64);
+        for &y in &level.orbit {
+            write_varint(out, y as u64);
+        }
+        write_varint(out, level.transversal.len() as u64);
+        for entry in &level.transversal {
+            match entry {
+                Some(sp) => {
+                    out.push(1);
+                    write_signed_perm(out, sp);
+                }
+                None => out.push(0),
+            }
+        }
+        write_varint(out, level.gens.len() as u64);
+        for gen in &level.gens {
+            write_signed_perm(out, gen);
+        }
+    }
+}
+
+/// Reads the BSGS payload without the magic header (shared with snapshots)
+pub(crate) fn read_bsgs_body(reader: &mut Reader<'_>) -> Result<BSGS> {
+    let base_len = reader.read_varint()? as usize;
+    let mut base = Vec::with_capacity(base_len);
+    for _ in 0..base_len {
+        base.push(reader.read_varint()? as usize);
+    }
+
+    let gens_len = reader.read_varint()? as usize;
+    let mut generators = Vec::with_capacity(gens_len);
+    for _ in 0..gens_len {
+        generators.push(read_signed_perm(reader)?);
+    }
+
+    let levels_len = reader.read_varint()? as usize;
+    let mut levels = Vec::with_capacity(levels_len);
+    for _ in 0..levels_len {
+        let point = reader.read_varint()? as usize;
+        let orbit_len = reader.read_varint()? as usize;
+        let mut orbit = Vec::with_capacity(orbit_len);
+        for _ in 0..orbit_len {
+            orbit.push(reader.read_varint()? as usize);
+        }
+        let transversal_len = reader.read_varint()? as usize;
+        let mut transversal = Vec::with_capacity(transversal_len);
+        for _ in 0..transversal_len {
+            if reader.read_u8()? != 0 {
+                transversal.push(Some(read_signed_perm(reader)?));
+            } else {
+                transversal.push(None);
+            }
+        }
+        let level_gens_len = reader.read_varint()? as usize;
+        let mut gens = Vec::with_capacity(level_gens_len);
+        for _ in 0..level_gens_len {
+            gens.push(read_signed_perm(reader)?);
+        }
+        levels.push(ChainLevel {
+            point,
+            orbit,
+            transversal,
+            gens,
+        });
+    }
+
+    Ok(BSGS {
+        base,
+        generators,
+        levels,
+    })
+}
+
+/// Magic header bytes for a canonicalizer snapshot
+pub(crate) fn snapshot_magic() -> [u8; 4] {
+    SNAPSHOT_MAGIC
+}
+
+/// Encodes one symmetry with a tag byte and varint payload
+pub(crate) fn write_symmetry(out: &mut Vec<u8>, symmetry: &Symmetry) {
+    match symmetry {
+        Symmetry::Symmetric { indices } => {
+            out.push(0);
+            write_usize_list(out, indices);
+        }
+        Symmetry::Antisymmetric { indices } => {
+            out.push(1);
+            write_usize_list(out, indices);
+        }
+        Symmetry::SymmetricPairs { pairs } => {
+            out.push(2);
+            write_varint(out, pairs.len() as u64);
+            for &(a, b) in pairs {
+                write_varint(out, a as u64);
+                write_varint(out, b as u64);
+            }
+        }
+        Symmetry::Cyclic { indices } => {
+            out.push(3);
+            write_usize_list(out, indices);
+        }
+        Symmetry::Custom {
+            valid_permutations,
+            signs,
+        } => {
+            out.push(4);
+            write_varint(out, valid_permutations.len() as u64);
+            for perm in valid_permutations {
+                write_usize_list(out, perm);
+            }
+            write_varint(out, signs.len() as u64);
+            for &sign in signs {
+                write_signed(out, i64::from(sign));
+            }
+        }
+        Symmetry::CustomPacked { perms } => {
+            out.push(5);
+            write_varint(out, perms.degree() as u64);
+            write_varint(out, perms.len() as u64);
+            for &word in perms.words() {
+                write_varint(out, word);
+            }
+        }
+    }
+}
+
+/// Decodes one symmetry written by [`write_symmetry`]
+pub(crate) fn read_symmetry(reader: &mut Reader<'_>) -> Result<Symmetry> {
+    let tag = reader.read_u8()?;
+    match tag {
+        0 => Ok(Symmetry::symmetric(read_usize_list(reader)?)),
+        1 => Ok(Symmetry::antisymmetric(read_usize_list(reader)?)),
+        2 => {
+            let len = reader.read_varint()? as usize;
+            let mut pairs = Vec::with_capacity(len);
+            for _ in 0..len {
+                let a = reader.read_varint()? as usize;
+                let b = reader.read_varint()? as usize;
+                pairs.push((a, b));
+            }
+            Ok(Symmetry::symmetric_pairs(pairs))
+        }
+        3 => Ok(Symmetry::cyclic(read_usize_list(reader)?)),
+        4 => {
+            let perm_count = reader.read_varint()? as usize;
+            let mut valid_permutations = Vec::with_capacity(perm_count);
+            for _ in 0..perm_count {
+                valid_permutations.push(read_usize_list(reader)?);
+            }
+            let sign_count = reader.read_varint()? as usize;
+            let mut signs = Vec::with_capacity(sign_count);
+            for _ in 0..sign_count {
+                signs.push(reader.read_signed()? as i32);
+            }
+            Ok(Symmetry::custom(valid_permutations, signs))
+        }
+        5 => {
+            let degree = reader.read_varint()? as usize;
+            let count = reader.read_varint()? as usize;
+            let mut words = Vec::with_capacity(count);
+            for _ in 0..count {
+                words.push(reader.read_varint()?);
+            }
+            Ok(Symmetry::CustomPacked {
+                perms: std::sync::Arc::new(crate::symmetry::PackedPerms::from_raw(degree, words)),
+            })
+        }
+        _ => Err(ButlerPortugalError::InvalidSymmetry(format!(
+            "Unknown symmetry tag {tag} in serialized data"
+        ))),
+    }
+}
+
+fn write_signed_perm(out: &mut Vec<u8>, sp: &SignedPerm) {
+    write_usize_list(out, &sp.perm);
+    write_signed(out, i64::from(sp.sign));
+}
+
+fn read_signed_perm(reader: &mut Reader<'_>) -> Result<SignedPerm> {
+    let perm: Permutation = read_usize_list(reader)?;
+    let sign = reader.read_signed()? as i32;
+    Ok(SignedPerm { perm, sign })
+}
+
+fn write_usize_list(out: &mut Vec<u8>, values: &[usize]) {
+    write_varint(out, values.len() as u64);
+    for &v in values {
+        write_varint(out, v as u64);
+    }
+}
+
+fn read_usize_list(reader: &mut Reader<'_>) -> Result<Vec<usize>> {
+    let len = reader.read_varint()? as usize;
+    let mut values = Vec::with_capacity(len);
+    for _ in 0..len {
+        values.push(reader.read_varint()? as usize);
+    }
+    Ok(values)
+}
+
+/// Appends an LEB128 varint
+pub(crate) fn write_varint(out: &mut Vec<u8>, mut value: u64) {
+    loop {
+        let byte = (value & 0x7f) as u8;
+        value >>= 7;
+        if value == 0 {
+            out.push(byte);
+            return;
+        }
+        out.push(byte | 0x80);
+    }
+}
+
+/// Appends a zigzag-encoded signed varint
+pub(crate) fn write_signed(out: &mut Vec<u8>, value: i64) {
+    write_varint(out, ((value << 1) ^ (value >> 63)) as u64);
+}
+
+/// Appends a varint of up to 128 bits (for exact coefficient parts)
+pub(crate) fn write_varint_wide(out: &mut Vec<u8>, mut value: u128) {
+    loop {
+        let byte = (value & 0x7f) as u8;
+        value >>= 7;
+        if value == 0 {
+            out.push(byte);
+            return;
+        }
+        out.push(byte | 0x80);
+    }
+}
+
+/// Appends a zigzag-encoded signed varint of up to 128 bits
+pub(crate) fn write_signed_wide(out: &mut Vec<u8>, value: i128) {
+    write_varint_wide(out, ((value << 1) ^ (value >> 127)) as u128);
+}
+
+/// Appends a varint-length-prefixed UTF-8 string
+pub(crate) fn write_str(out: &mut Vec<u8>, s: &str) {
+    write_varint(out, s.len() as u64);
+    out.extend_from_slice(s.as_bytes());
+}
+
+/// Cursor over a serialized buffer with bounds-checked reads
+pub(crate) struct Reader<'a> {
+    buf: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> Reader<'a> {
+    pub(crate) fn new(buf: &'a [u8]) -> Self {
+        Self { buf, pos: 0 }
+    }
+
+    /// Number of unread bytes left in the buffer
+    pub(crate) fn remaining(&self) -> usize {
+        self.buf.len() - self.pos
+    }
+
+    pub(crate) fn expect_magic(&mut self, magic: &[u8; 4], what: &str) -> Result<()> {
+        let got = self.read_bytes(4)?;
+        if got != magic {
+            return Err(ButlerPortugalError::ComputationError(format!(
+                "Not a serialized {what} (bad magic or unsupported version)"
+            )));
+        }
+        Ok(())
+    }
+
+    pub(crate) fn read_u8(&mut self) -> Result<u8> {
+        let bytes = self.read_bytes(1)?;
+        Ok(bytes[0])
+    }
+
+    pub(crate) fn read_bytes(&mut self, n: usize) -> Result<&'a [u8]> {
+        let end = self.pos.checked_add(n).filter(|&e| e <= self.buf.len());
+        let Some(end) = end else {
+            return Err(ButlerPortugalError::ComputationError(
+                "Serialized data truncated".to_string(),
+            ));
+        };
+        let slice = &self.buf[self.pos..end];
+        self.pos = end;
+        Ok(slice)
+    }
+
+    pub(crate) fn read_varint(&mut self) -> Result<u64> {
+        let mut value = 0u64;
+        let mut shift = 0;
+        loop {
+            let byte = self.read_u8()?;
+            value |= u64::from(byte & 0x7f) << shift;
+            if byte & 0x80 == 0 {
+                return Ok(value);
+            }
+            shift += 7;
+            if shift >= 64 {
+                return Err(ButlerPortugalError::ComputationError(
+                    "Varint overflow in serialized data".to_string(),
+                ));
+            }
+        }
+    }
+
+    pub(crate) fn read_signed(&mut self) -> Result<i64> {
+        let raw = self.read_varint()?;
+        Ok(((raw >> 1) as i64) ^ -((raw & 1) as i64))
+    }
+
+    pub(crate) fn read_varint_wide(&mut self) -> Result<u128> {
+        let mut value = 0u128;
+        let mut shift = 0;
+        loop {
+            let byte = self.read_u8()?;
+            value |= u128::from(byte & 0x7f) << shift;
+            if byte & 0x80 == 0 {
+                return Ok(value);
+            }
+            shift += 7;
+            if shift >= 128 {
+                return Err(ButlerPortugalError::ComputationError(
+                    "Varint overflow in serialized data".to_string(),
+                ));
+            }
+        }
+    }
+
+    pub(crate) fn read_signed_wide(&mut self) -> Result<i128> {
+        let raw = self.read_varint_wide()?;
+        Ok(((raw >> 1) as i128) ^ -((raw & 1) as i128))
+    }
+
+    pub(crate) fn read_str(&mut self) -> Result<String> {
+        let len = self.read_varint()? as usize;
+        let bytes = self.read_bytes(len)?;
+        String::from_utf8(bytes.to_vec()).map_err(|_| {
+            ButlerPortugalError::ComputationError(
+                "Invalid UTF-8 string in serialized data".to_string(),
+            )
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::schreier_sims::schreier_sims;
+
+    #[test]
+    fn test_tensor_roundtrip() {
+        let mut tensor = Tensor::with_coefficient(
+            "R",
+            vec![
+                TensorIndex::new("a", 0),
+                TensorIndex::contravariant("a", 1),
+                TensorIndex::new("c", 2),
+                TensorIndex::new("d", 3),
+            ],
+            -3,
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![2, 3]));
+        tensor.add_symmetry(Symmetry::symmetric_pairs(vec![(0, 1), (2, 3)]));
+        if let Err(e) = tensor.add_contraction(1, 0) {
+            panic!("contraction failed: {e}");
+        }
+
+        let bytes = tensor.to_bytes();
+        let restored = match Tensor::from_bytes(&bytes) {
+            Ok(t) => t,
+            Err(e) => panic!("deserialization failed: {e}"),
+        };
+        assert_eq!(restored, tensor);
+    }
+
+    #[test]
+    fn test_packed_symmetry_roundtrip() {
+        let mut tensor = Tensor::new(
+            "T",
+            vec![TensorIndex::new("a", 0), TensorIndex::new("b", 1)],
+        );
+        tensor.add_symmetry(Symmetry::custom_packed(
+            vec![vec![0, 1], vec![1, 0]],
+            vec![1, -1],
+        ));
+
+        let bytes = tensor.to_bytes();
+        let restored = match Tensor::from_bytes(&bytes) {
+            Ok(t) => t,
+            Err(e) => panic!("deserialization failed: {e}"),
+        };
+        assert_eq!(restored, tensor);
+        assert_eq!(restored.symmetries()[0].permutation_sign(&[1, 0]), -1);
+    }
+
+    #[test]
+    fn test_tensor_rejects_bad_magic() {
+        assert!(Tensor::from_bytes(b"nope").is_err());
+        assert!(Tensor::from_bytes(&[]).is_err());
+    }
+
+    #[test]
+    fn test_bsgs_roundtrip() {
+        let gens = vec![
+            SignedPerm {
+                perm: vec![1, 0, 2, 3],
+                sign: -1,
+            },
+            SignedPerm {
+                perm: vec![0, 1, 3, 2],
+                sign: -1,
+            },
+        ];
+        let bsgs = schreier_sims(&gens, 4);
+        let bytes = bsgs.to_bytes();
+        let restored = match BSGS::from_bytes(&bytes) {
+            Ok(b) => b,
+            Err(e) => panic!("deserialization failed: {e}"),
+        };
+        assert_eq!(restored.base, bsgs.base);
+        assert_eq!(restored.generators, bsgs.generators);
+        assert_eq!(restored.levels.len(), bsgs.levels.len());
+        for (a, b) in restored.levels.iter().zip(&bsgs.levels) {
+            assert_eq!(a.point, b.point);
+            assert_eq!(a.orbit, b.orbit);
+            assert_eq!(a.transversal, b.transversal);
+            assert_eq!(a.gens, b.gens);
+        }
+    }
+
+    #[test]
+    fn test_snapshot_restores_cache() {
+        let ctx = crate::CanonicalizerContext::new();
+        let mut tensor = Tensor::new(
+            "R",
+            vec![
+                TensorIndex::new("b", 0),
+                TensorIndex::new("a", 1),
+                TensorIndex::new("d", 2),
+                TensorIndex::new("c", 3),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![2, 3]));
+
+        let expected = match ctx.canonicalize(&tensor) {
+            Ok(t) => t,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert_eq!(ctx.cached_signatures(), 1);
+
+        let bytes = ctx.snapshot();
+        let restored = match crate::CanonicalizerContext::restore(&bytes) {
+            Ok(c) => c,
+            Err(e) => panic!("restore failed: {e}"),
+        };
+        assert_eq!(restored.cached_signatures(), 1);
+        let again = match restored.canonicalize(&tensor) {
+            Ok(t) => t,
+            Err(e) => panic!("canonicalize failed: {e}"),
+        };
+        assert_eq!(again, expected);
+    }
+
+    #[test]
+    fn test_varint_roundtrip() {
+        let mut out = Vec::new();
+        for value in [0u64, 1, 127, 128, 300, u64::from(u32::MAX), u64::MAX] {
+            out.clear();
+            write_varint(&mut out, value);
+            let mut reader = Reader::new(&out);
+            assert_eq!(reader.read_varint().ok(), Some(value));
+        }
+        out.clear();
+        for value in [0i64, -1, 1, -64, 64, i64::MIN, i64::MAX] {
+            out.clear();
+            write_signed(&mut out, value);
+            let mut reader = Reader::new(&out);
+            assert_eq!(reader.read_signed().ok(), Some(value));
+        }
+    }
+}
@@ -0,0 +1,366 @@
+//! Streaming canonicalization of tensor expressions
+//!
+//! Consumes a flat record format of tensor terms from a byte buffer (for
+//! example a memory-mapped file), canonicalizes every term through a shared
+//! BSGS cache with a bounded worker pool, and emits canonical records with
+//! the coefficients of colliding terms combined. This replaces driving
+//! [`canonicalize`](crate::canonicalization::canonicalize) term by term from
+//! an external process, where marshalling tensors in and out of the library
+//! dominates wall time.
+//!
+//! A stream starts with a table of symmetry signatures (symmetry list plus
+//! contracted slot pairs); each term record then references its signature by
+//! id, so the per-term payload is just the name, the index names with their
+//! variance, and a coefficient. Build streams with [`StreamWriter`], read
+//! them back with [`StreamReader`], and run the whole pipeline stage with
+//! [`canonicalize_stream`] or
+//! [`CanonicalizerContext::canonicalize_stream`].
+
+use std::collections::HashMap;
+
+use crate::canonicalization::CanonicalizerContext;
+use crate::coefficient::Coefficient;
+use crate::error::Result;
+use crate::serialization::{
+    read_symmetry, write_signed_wide, write_str, write_symmetry, write_varint, write_varint_wide,
+    Reader,
+};
+use crate::symmetry::Symmetry;
+use crate::tensor::Tensor;
+use crate::ButlerPortugalError;
+use crate::TensorIndex;
+
+/// Format magic and version for a term stream (version 2: exact rational
+/// coefficients instead of truncated integers)
+const STREAM_MAGIC: [u8; 4] = [b'B', b'P', b'S', 2];
+
+/// A stream-table entry: a symmetry list and its contracted slot pairs
+type StreamSignature = (Vec<Symmetry>, Vec<(usize, usize)>);
+
+/// Incrementally builds a term stream in the flat record format
+///
+/// Signatures are registered once and shared by id across records, so a
+/// sum with thousands of terms over a handful of symmetry types pays for
+/// each symmetry list exactly once.
+#[derive(Debug, Default)]
+pub struct StreamWriter {
+    signatures: Vec<StreamSignature>,
+    records: Vec<u8>,
+    num_records: usize,
+}
+
+impl StreamWriter {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Registers a symmetry signature and returns its id for use in
+    /// [`StreamWriter::add_term`]
+    pub fn add_signature(
+        &mut self,
+        symmetries: Vec<Symmetry>,
+        contractions: Vec<(usize, usize)>,
+    ) -> usize {
+        self.signatures.push((symmetries, contractions));
+        self.signatures.len() - 1
+    }
+
+    /// Appends one term record referencing a previously registered signature
+    pub fn add_term(
+        &mut self,
+        name: &str,
+        indices: &[TensorIndex],
+        signature: usize,
+        coefficient: impl Into<Coefficient>,
+    ) -> Result<()> {
+        if signature >= self.signatures.len() {
+            return Err(ButlerPortugalError::ComputationError(format!(
+                "Stream record references unregistered signature {signature}"
+            )));
+        }
+        write_str(&mut self.records, name);
+        write_varint(&mut self.records, signature as u64);
+        write_varint(&mut self.records, indices.len() as u64);
+        for index in indices {
+            write_str(&mut self.records, index.name());
+            self.records.push(u8::from(index.is_contravariant()));
+        }
+        let (num, den) = coefficient.into().parts();
+        write_signed_wide(&mut self.records, num);
+        write_varint_wide(&mut self.records, den as u128);
+        self.num_records += 1;
+        Ok(())
+    }
+
+    /// Finalizes the stream and returns the complete buffer
+    pub fn finish(self) -> Vec<u8> {
+        let mut out = Vec::with_capacity(self.records.len() + 64);
+        out.extend_from_slice(&STREAM_MAGIC);
+        write_varint(&mut out, self.signatures.len() as u64);
+        for (symmetries, contractions) in &self.signatures {
+            write_varint(&mut out, symmetries.len() as u64);
+            for symmetry in symmetries {
+                write_symmetry(&mut out, symmetry);
+            }
+            write_varint(&mut out, contractions.len() as u64);
+            for &(u, l) in contractions {
+                write_varint(&mut out, u as u64);
+                write_varint(&mut out, l as u64);
+            }
+        }
+        write_varint(&mut out, self.num_records as u64);
+        out.extend_from_slice(&self.records);
+        out
+    }
+}
+
+/// Reads term records out of a stream buffer, yielding one [`Tensor`] per
+/// record with its signature's symmetries and contractions applied
+pub struct StreamReader<'a> {
+    reader: Reader<'a>,
+    signatures: Vec<StreamSignature>,
+    remaining_records: usize,
+}
+
+impl<'a> StreamReader<'a> {
+    /// Parses the stream header; record iteration happens lazily
+    pub fn new(bytes: &'a [u8]) -> Result<Self> {
+        let mut reader = Reader::new(bytes);
+        reader.expect_magic(&STREAM_MAGIC, "term stream")?;
+        let num_signatures = reader.read_varint()? as usize;
+        let mut signatures = Vec::with_capacity(num_signatures);
+        for _ in 0..num_signatures {
+            let num_symmetries = reader.read_varint()? as usize;
+            let mut symmetries = Vec::with_capacity(num_symmetries);
+            for _ in 0..num_symmetries {
+                symmetries.push(read_symmetry(&mut reader)?);
+            }
+            let num_contractions = reader.read_varint()? as usize;
+            let mut contractions = Vec::with_capacity(num_contractions);
+            for _ in 0..num_contractions {
+                let u = reader.read_varint()? as usize;
+                let l = reader.read_varint()? as usize;
+                contractions.push((u, l));
+            }
+            signatures.push((symmetries, contractions));
+        }
+        let remaining_records = reader.read_varint()? as usize;
+        Ok(Self {
+            reader,
+            signatures,
+            remaining_records,
+        })
+    }
+
+    /// Reads one record, returning the reconstructed tensor and its
+    /// signature id
+    fn read_record(&mut self) -> Result<(Tensor, usize)> {
+        let name = self.reader.read_str()?;
+        let signature = self.reader.read_varint()? as usize;
+        let (symmetries, contractions) = self.signatures.get(signature).ok_or_else(|| {
+            ButlerPortugalError::ComputationError(format!(
+                "Stream record references unknown signature {signature}"
+            ))
+        })?;
+        let (symmetries, contractions) = (symmetries.clone(), contractions.clone());
+
+        let rank = self.reader.read_varint()? as usize;
+        let mut indices = Vec::with_capacity(rank);
+        for position in 0..rank {
+            let index_name = self.reader.read_str()?;
+            let contravariant = self.reader.read_u8()? != 0;
+            indices.push(if contravariant {
+                TensorIndex::contravariant(&index_name, position)
+            } else {
+                TensorIndex::new(&index_name, position)
+            });
+        }
+        let num = self.reader.read_signed_wide()?;
+        let den = self.reader.read_varint_wide()? as i128;
+        let coefficient = Coefficient::from_wide(num, den);
+
+        let mut tensor = Tensor::with_coefficient(&name, indices, coefficient);
+        for symmetry in symmetries {
+            tensor.add_symmetry(symmetry);
+        }
+        for (u, l) in contractions {
+            tensor.add_contraction(u, l)?;
+        }
+        Ok((tensor, signature))
+    }
+}
+
+impl Iterator for StreamReader<'_> {
+    type Item = Result<(Tensor, usize)>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.remaining_records == 0 || self.reader.remaining() == 0 {
+            return None;
+        }
+        self.remaining_records -= 1;
+        Some(self.read_record())
+    }
+}
+
+/// Canonicalizes every term of a stream and collects the sum
+///
+/// Terms are canonicalized in parallel through the context's shared BSGS
+/// cache (the same bounded worker pool as
+/// [`CanonicalizerContext::canonicalize_batch`]). Canonical terms with
+/// identical name and index arrangement have their coefficients summed;
+/// terms that cancel or vanish identically are dropped. The result is a new
+/// stream in the same format, with output records in first-appearance order
+/// of their canonical form.
+pub fn canonicalize_stream(input: &[u8]) -> Result<Vec<u8>> {
+    CanonicalizerContext::new().canonicalize_stream(input)
+}
+
+impl CanonicalizerContext {
+    /// Streaming counterpart of [`CanonicalizerContext::canonicalize_batch`];
+    /// see [`canonicalize_stream`]
+    pub fn canonicalize_stream(&self, input: &[u8]) -> Result<Vec<u8>> {
+        let mut terms = Vec::new();
+        let mut term_signatures = Vec::new();
+        let mut signatures = Vec::new();
+        let mut reader = StreamReader::new(input)?;
+        signatures.extend(reader.signatures.iter().cloned());
+        for record in &mut reader {
+            let (tensor, signature) = record?;
+            terms.push(tensor);
+            term_signatures.push(signature);
+        }
+
+        let canonical = self.canonicalize_batch(&terms);
+
+        // Sum-collection: combine coefficients of terms whose canonical
+        // forms coincide, keeping first-appearance order
+        let mut order: Vec<(Tensor, usize)> = Vec::new();
+        let mut collected: HashMap<(String, Vec<(String, bool)>), usize> = HashMap::new();
+        for (result, &signature) in canonical.into_iter().zip(&term_signatures) {
+            let tensor = result?;
+            if tensor.coefficient().is_zero() {
+                continue;
+            }
+            let key = (
+                tensor.name().to_string(),
+                tensor
+                    .indices()
+                    .iter()
+                    .map(|i| (i.name().to_string(), i.is_contravariant()))
+                    .collect(),
+            );
+            if let Some(&slot) = collected.get(&key) {
+                let combined = order[slot].0.coefficient() + tensor.coefficient();
+                order[slot].0.set_coefficient(combined);
+            } else {
+                collected.insert(key, order.len());
+                order.push((tensor, signature));
+            }
+        }
+
+        let mut writer = StreamWriter::new();
+        for (symmetries, contractions) in signatures {
+            writer.add_signature(symmetries, contractions);
+        }
+        for (tensor, signature) in &order {
+            if tensor.coefficient().is_zero() {
+                continue;
+            }
+            writer.add_term(
+                tensor.name(),
+                tensor.indices(),
+                *signature,
+                tensor.coefficient(),
+            )?;
+        }
+        Ok(writer.finish())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn collect_terms(stream: &[u8]) -> Vec<Tensor> {
+        let reader = match StreamReader::new(stream) {
+            Ok(r) => r,
+            Err(e) => panic!("stream header parse failed: {e}"),
+        };
+        reader
+            .map(|record| match record {
+                Ok((tensor, _)) => tensor,
+                Err(e) => panic!("record parse failed: {e}"),
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_stream_roundtrip() {
+        let mut writer = StreamWriter::new();
+        let sig = writer.add_signature(vec![Symmetry::symmetric(vec![0, 1])], vec![]);
+        let indices = vec![TensorIndex::new("b", 0), TensorIndex::contravariant("a", 1)];
+        if let Err(e) = writer.add_term("T", &indices, sig, 2) {
+            panic!("add_term failed: {e}");
+        }
+        let stream = writer.finish();
+
+        let terms = collect_terms(&stream);
+        assert_eq!(terms.len(), 1);
+        assert_eq!(terms[0].name(), "T");
+        assert_eq!(terms[0].coefficient(), 2);
+        assert_eq!(terms[0].indices(), &indices[..]);
+        assert_eq!(terms[0].symmetries().len(), 1);
+    }
+
+    #[test]
+    fn test_stream_rejects_unknown_signature() {
+        let mut writer = StreamWriter::new();
+        let indices = vec![TensorIndex::new("a", 0)];
+        assert!(writer.add_term("T", &indices, 0, 1).is_err());
+    }
+
+    #[test]
+    fn test_canonicalize_stream_collects_sum() {
+        let mut writer = StreamWriter::new();
+        let sig = writer.add_signature(vec![Symmetry::antisymmetric(vec![0, 1])], vec![]);
+        // F_{ba} + 2*F_{ab} canonicalizes to F_{ab} with coefficient 1
+        let swapped = vec![TensorIndex::new("b", 0), TensorIndex::new("a", 1)];
+        let sorted = vec![TensorIndex::new("a", 0), TensorIndex::new("b", 1)];
+        if let Err(e) = writer.add_term("F", &swapped, sig, 1) {
+            panic!("add_term failed: {e}");
+        }
+        if let Err(e) = writer.add_term("F", &sorted, sig, 2) {
+            panic!("add_term failed: {e}");
+        }
+        let output = match canonicalize_stream(&writer.finish()) {
+            Ok(o) => o,
+            Err(e) => panic!("canonicalize_stream failed: {e}"),
+        };
+
+        let terms = collect_terms(&output);
+        assert_eq!(terms.len(), 1);
+        assert_eq!(terms[0].name(), "F");
+        assert_eq!(terms[0].coefficient(), 1);
+        assert_eq!(terms[0].indices()[0].name(), "a");
+        assert_eq!(terms[0].indices()[1].name(), "b");
+    }
+
+    #[test]
+    fn test_canonicalize_stream_drops_cancelling_terms() {
+        let mut writer = StreamWriter::new();
+        let sig = writer.add_signature(vec![Symmetry::antisymmetric(vec![0, 1])], vec![]);
+        let swapped = vec![TensorIndex::new("b", 0), TensorIndex::new("a", 1)];
+        let sorted = vec![TensorIndex::new("a", 0), TensorIndex::new("b", 1)];
+        if let Err(e) = writer.add_term("F", &swapped, sig, 1) {
+            panic!("add_term failed: {e}");
+        }
+        if let Err(e) = writer.add_term("F", &sorted, sig, 1) {
+            panic!("add_term failed: {e}");
+        }
+        let output = match canonicalize_stream(&writer.finish()) {
+            Ok(o) => o,
+            Err(e) => panic!("canonicalize_stream failed: {e}"),
+        };
+        assert!(collect_terms(&output).is_empty());
+    }
+}
@@ -5,13 +5,14 @@
 
 use crate::index::TensorIndex;
 use std::collections::HashSet;
+use std::sync::Arc;
 
 /// Represents different types of tensor symmetries
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
 pub enum Symmetry {
     /// Symmetric in a group of indices
     Symmetric { indices: Vec<usize> },
-    /// Antisymmetric in a group of indices  
+    /// Antisymmetric in a group of indices
     Antisymmetric { indices: Vec<usize> },
     /// Symmetric exchange between pairs of indices
     SymmetricPairs { pairs: Vec<(usize, usize)> },
@@ -22,6 +23,124 @@ pub enum Symmetry {
         valid_permutations: Vec<Vec<usize>>,
         signs: Vec<i32>,
     },
+    /// Custom symmetry in packed form: one contiguous word buffer instead
+    /// of a vector of heap vectors; see [`Symmetry::custom_packed`]
+    CustomPacked { perms: Arc<PackedPerms> },
+}
+
+/// Sign bit of a packed permutation word (set for -1)
+const PACKED_SIGN_BIT: u64 = 1 << 63;
+
+/// Largest degree a packed word can hold: 15 entries of 4 bits leave the
+/// sign bit free
+const PACKED_MAX_DEGREE: usize = 15;
+
+/// A contiguous store of signed permutations, one `u64` word each
+///
+/// Entry `i` of a permutation lives in bits `4i..4i+4` and the sign in the
+/// top bit, so a machine-generated group of thousands of elements is one
+/// flat buffer scanned linearly instead of a `Vec<Vec<usize>>` chased
+/// pointer by pointer. Membership lookup packs the query once and compares
+/// whole words.
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
+pub struct PackedPerms {
+    degree: usize,
+    words: Vec<u64>,
+}
+
+impl PackedPerms {
+    /// Packs explicit permutations with their signs; `None` when the lists
+    /// differ in length, the degree exceeds 15, or an entry is out of range
+    pub fn pack(valid_permutations: &[Vec<usize>], signs: &[i32]) -> Option<Self> {
+        if valid_permutations.len() != signs.len() {
+            return None;
+        }
+        let degree = valid_permutations.first().map_or(0, Vec::len);
+        if degree > PACKED_MAX_DEGREE {
+            return None;
+        }
+        let mut words = Vec::with_capacity(valid_permutations.len());
+        for (perm, &sign) in valid_permutations.iter().zip(signs) {
+            if perm.len() != degree {
+                return None;
+            }
+            let mut word = pack_word(perm)?;
+            if sign < 0 {
+                word |= PACKED_SIGN_BIT;
+            }
+            words.push(word);
+        }
+        Some(Self { degree, words })
+    }
+
+    /// Rebuilds the store from its raw parts (serialization)
+    pub(crate) fn from_raw(degree: usize, words: Vec<u64>) -> Self {
+        Self { degree, words }
+    }
+
+    /// The number of slots each stored permutation acts on
+    pub fn degree(&self) -> usize {
+        self.degree
+    }
+
+    /// The number of stored permutations
+    pub fn len(&self) -> usize {
+        self.words.len()
+    }
+
+    /// True when no permutations are stored
+    pub fn is_empty(&self) -> bool {
+        self.words.is_empty()
+    }
+
+    /// The raw packed words (serialization)
+    pub(crate) fn words(&self) -> &[u64] {
+        &self.words
+    }
+
+    /// Sign of a stored permutation matching the query exactly, or 0 when
+    /// absent; the scan packs the query once and compares whole words, no
+    /// per-element allocation or indirection
+    pub fn sign_of(&self, permutation: &[usize]) -> i32 {
+        if permutation.len() != self.degree {
+            return 0;
+        }
+        let Some(query) = pack_word(permutation) else {
+            return 0;
+        };
+        for &word in &self.words {
+            if word & !PACKED_SIGN_BIT == query {
+                return if word & PACKED_SIGN_BIT != 0 { -1 } else { 1 };
+            }
+        }
+        0
+    }
+
+    /// Iterates the buffer in place, decoding each `(permutation, sign)`
+    /// pair only as it is yielded
+    pub fn iter(&self) -> impl Iterator<Item = (Vec<usize>, i32)> + '_ {
+        self.words.iter().map(move |&word| {
+            let mut perm = Vec::with_capacity(self.degree);
+            for i in 0..self.degree {
+                perm.push(((word >> (4 * i)) & 0xF) as usize);
+            }
+            let sign = if word & PACKED_SIGN_BIT != 0 { -1 } else { 1 };
+            (perm, sign)
+        })
+    }
+}
+
+/// Packs a permutation into the low 4-bit lanes of one word; `None` when an
+/// entry does not fit a lane
+fn pack_word(perm: &[usize]) -> Option<u64> {
+    let mut word = 0u64;
+    for (i, &v) in perm.iter().enumerate() {
+        if v > PACKED_MAX_DEGREE {
+            return None;
+        }
+        word |= (v as u64) << (4 * i);
+    }
+    Some(word)
 }
 
 impl Symmetry {
@@ -98,6 +217,27 @@ impl Symmetry {
         }
     }
 
+    /// Creates custom symmetry stored in packed form
+    ///
+    /// Each permutation is packed into one 64-bit word (4 bits per entry,
+    /// sign in the top bit) held in a single contiguous, cheaply shared
+    /// buffer, so large machine-generated groups cost eight bytes per
+    /// element instead of a heap vector each, and sign lookups compare
+    /// whole words. Permutations longer than 15 entries do not fit a word;
+    /// those (and malformed inputs) fall back to the unpacked
+    /// [`Symmetry::custom`] representation.
+    pub fn custom_packed(valid_permutations: Vec<Vec<usize>>, signs: Vec<i32>) -> Self {
+        match PackedPerms::pack(&valid_permutations, &signs) {
+            Some(packed) => Self::CustomPacked {
+                perms: Arc::new(packed),
+            },
+            None => Self::Custom {
+                valid_permutations,
+                signs,
+            },
+        }
+    }
+
     /// Returns the sign change when swapping two specific indices
     ///
     /// # Arguments
@@ -173,6 +313,11 @@ impl Symmetry {
                     0 // Invalid permutation
                 }
             }
+            Self::CustomPacked { perms } => {
+                let mut perm = (0..std::cmp::max(i, j) + 1).collect::<Vec<_>>();
+                perm.swap(i, j);
+                perms.sign_of(&perm)
+            }
         }
     }
 
@@ -205,6 +350,7 @@ impl Symmetry {
                     0 // Invalid permutation
                 }
             }
+            Self::CustomPacked { perms } => perms.sign_of(permutation),
         }
     }
 
@@ -408,6 +554,59 @@ mod tests {
         assert!(asym.makes_tensor_zero(&indices));
     }
 
+    #[test]
+    fn test_custom_packed_matches_custom() {
+        let perms = vec![vec![0, 1, 2], vec![1, 0, 2], vec![2, 1, 0]];
+        let signs = vec![1, -1, -1];
+        let custom = Symmetry::custom(perms.clone(), signs.clone());
+        let packed = Symmetry::custom_packed(perms, signs);
+        assert!(matches!(packed, Symmetry::CustomPacked { .. }));
+
+        // Member, non-member and wrong-length queries all agree
+        for query in [
+            vec![0, 1, 2],
+            vec![1, 0, 2],
+            vec![2, 1, 0],
+            vec![0, 2, 1],
+            vec![0, 1],
+        ] {
+            assert_eq!(
+                packed.permutation_sign(&query),
+                custom.permutation_sign(&query),
+                "query {query:?}"
+            );
+        }
+        assert_eq!(
+            packed.sign_change_for_swap(0, 1),
+            custom.sign_change_for_swap(0, 1)
+        );
+    }
+
+    #[test]
+    fn test_custom_packed_falls_back_for_large_degree() {
+        // Sixteen entries leave no room for the sign bit, so the unpacked
+        // representation is kept
+        let identity: Vec<usize> = (0..16).collect();
+        let symmetry = Symmetry::custom_packed(vec![identity], vec![1]);
+        assert!(matches!(symmetry, Symmetry::Custom { .. }));
+    }
+
+    #[test]
+    fn test_packed_perms_roundtrip() {
+        let perms = vec![vec![1, 2, 0], vec![2, 0, 1]];
+        let signs = vec![1, -1];
+        let Some(packed) = PackedPerms::pack(&perms, &signs) else {
+            panic!("degree 3 must pack")
+        };
+        assert_eq!(packed.degree(), 3);
+        assert_eq!(packed.len(), 2);
+        let decoded: Vec<(Vec<usize>, i32)> = packed.iter().collect();
+        assert_eq!(decoded[0], (vec![1, 2, 0], 1));
+        assert_eq!(decoded[1], (vec![2, 0, 1], -1));
+        assert_eq!(packed.sign_of(&[2, 0, 1]), -1);
+        assert_eq!(packed.sign_of(&[0, 1, 2]), 0);
+    }
+
     #[test]
     fn test_cyclic_permutation_check() {
         assert!(is_cyclic_permutation(&[1, 2, 0])); // 0->1->2->0
@@ -3,10 +3,13 @@
 //! This module provides the core `Tensor` struct and associated methods
 //! for representing tensors with indices and symmetry properties.
 
+use crate::coefficient::Coefficient;
 use crate::index::TensorIndex;
 use crate::symmetry::Symmetry;
-use crate::young_tableaux::{young_symmetrizer_permutations, StandardTableau};
+use crate::young_tableaux::{young_symmetrizer, StandardTableau};
+use std::collections::{HashMap, HashSet};
 use std::fmt;
+use std::sync::Arc;
 
 /// Represents a tensor with indices and symmetry properties
 #[derive(Debug, Clone, PartialEq)]
@@ -15,10 +18,12 @@ pub struct Tensor {
     name: String,
     /// The indices of the tensor
     indices: Vec<TensorIndex>,
-    /// Symmetry properties of the tensor
-    symmetries: Vec<Symmetry>,
-    /// Optional coefficient (default is 1)
-    coefficient: i32,
+    /// Symmetry properties of the tensor, shared between permuted copies
+    symmetries: Arc<[Symmetry]>,
+    /// Contracted (dummy) slot pairs as `(contravariant, covariant)` positions
+    contractions: Vec<(usize, usize)>,
+    /// Exact rational coefficient (default is 1)
+    coefficient: Coefficient,
 }
 
 impl Tensor {
@@ -41,18 +46,24 @@ impl Tensor {
         Self {
             name: name.to_string(),
             indices,
-            symmetries: Vec::new(),
-            coefficient: 1,
+            symmetries: Arc::from(Vec::new()),
+            contractions: Vec::new(),
+            coefficient: Coefficient::integer(1),
         }
     }
 
     /// Creates a new tensor with a coefficient
-    pub fn with_coefficient(name: &str, indices: Vec<TensorIndex>, coefficient: i32) -> Self {
+    pub fn with_coefficient(
+        name: &str,
+        indices: Vec<TensorIndex>,
+        coefficient: impl Into<Coefficient>,
+    ) -> Self {
         Self {
             name: name.to_string(),
             indices,
-            symmetries: Vec::new(),
-            coefficient,
+            symmetries: Arc::from(Vec::new()),
+            contractions: Vec::new(),
+            coefficient: coefficient.into(),
         }
     }
 
@@ -77,13 +88,13 @@ impl Tensor {
     }
 
     /// Returns the coefficient
-    pub fn coefficient(&self) -> i32 {
-        self.coefficient
+    pub fn coefficient(&self) -> Coefficient {
+        self.coefficient.clone()
     }
 
     /// Sets the coefficient
-    pub fn set_coefficient(&mut self, coefficient: i32) {
-        self.coefficient = coefficient;
+    pub fn set_coefficient(&mut self, coefficient: impl Into<Coefficient>) {
+        self.coefficient = coefficient.into();
     }
 
     /// Adds a symmetry property to the tensor
@@ -91,12 +102,61 @@ impl Tensor {
     /// # Arguments
     /// * `symmetry` - The symmetry to add
     pub fn add_symmetry(&mut self, symmetry: Symmetry) {
-        self.symmetries.push(symmetry);
+        let mut symmetries = self.symmetries.to_vec();
+        symmetries.push(symmetry);
+        self.symmetries = Arc::from(symmetries);
     }
 
     /// Removes all symmetries
     pub fn clear_symmetries(&mut self) {
-        self.symmetries.clear();
+        self.symmetries = Arc::from(Vec::new());
+    }
+
+    /// Marks two slots as a contracted (dummy) pair
+    ///
+    /// The dummy name is arbitrary and the pair may be raised/lowered, so
+    /// canonicalization minimizes over relabelings and pair exchanges of all
+    /// marked pairs without any explicit permutation list.
+    ///
+    /// # Arguments
+    /// * `upper` - Position of the contravariant member of the pair
+    /// * `lower` - Position of the covariant member of the pair
+    pub fn add_contraction(&mut self, upper: usize, lower: usize) -> crate::Result<()> {
+        let rank = self.indices.len();
+        for &pos in &[upper, lower] {
+            if pos >= rank {
+                return Err(crate::ButlerPortugalError::IndexOutOfBounds {
+                    index: pos,
+                    max: rank,
+                });
+            }
+        }
+        if upper == lower {
+            return Err(crate::ButlerPortugalError::InvalidTensor(
+                "Contraction must pair two distinct slots".to_string(),
+            ));
+        }
+        if !self.indices[upper].is_contravariant() || self.indices[lower].is_contravariant() {
+            return Err(crate::ButlerPortugalError::InvalidTensor(
+                "Contraction must pair a contravariant slot with a covariant slot".to_string(),
+            ));
+        }
+        if self
+            .contractions
+            .iter()
+            .any(|&(u, l)| u == upper || u == lower || l == upper || l == lower)
+        {
+            return Err(crate::ButlerPortugalError::InvalidTensor(
+                "Slot already belongs to another contraction".to_string(),
+            ));
+        }
+        self.contractions.push((upper, lower));
+        Ok(())
+    }
+
+    /// Returns the contracted slot pairs as `(contravariant, covariant)` positions
+    pub fn contractions(&self) -> &[(usize, usize)] {
+        &self.contractions
     }
 
     /// Returns the rank (number of indices) of the tensor
@@ -120,7 +180,7 @@ impl Tensor {
 
         // Calculate sign change based on symmetries
         let mut sign = 1;
-        for symmetry in &self.symmetries {
+        for symmetry in self.symmetries.iter() {
             sign *= symmetry.sign_change_for_swap(i, j);
         }
 
@@ -148,14 +208,28 @@ impl Tensor {
                     "Permutation index {p} out of bounds"
                 )));
             }
-            new_indices.push(self.indices[p].clone());
+            new_indices.push(self.indices[p]);
+        }
+
+        // Remap contracted slots: old slot `permutation[i]` lands in slot `i`
+        let mut new_contractions = self.contractions.clone();
+        if !new_contractions.is_empty() {
+            let mut new_slot = vec![0usize; permutation.len()];
+            for (i, &p) in permutation.iter().enumerate() {
+                new_slot[p] = i;
+            }
+            for (u, l) in &mut new_contractions {
+                *u = new_slot[*u];
+                *l = new_slot[*l];
+            }
         }
 
         let mut new_tensor = Self {
             name: self.name.clone(),
             indices: new_indices,
-            symmetries: self.symmetries.clone(),
-            coefficient: self.coefficient,
+            symmetries: Arc::clone(&self.symmetries),
+            contractions: new_contractions,
+            coefficient: self.coefficient.clone(),
         };
 
         // Calculate sign change for this permutation
@@ -165,12 +239,96 @@ impl Tensor {
         Ok(new_tensor)
     }
 
+    /// Applies a permutation to this tensor in place
+    ///
+    /// Slot `i` receives the index previously at slot `permutation[i]` and
+    /// the coefficient picks up the symmetry sign, exactly as
+    /// [`Tensor::permute`] - but the existing index storage is rearranged
+    /// by following the permutation's cycles with swaps, so nothing is
+    /// cloned or allocated.
+    pub fn permute_in_place(&mut self, permutation: &[usize]) -> crate::Result<()> {
+        // A duplicate entry would make the cycle walk below loop forever,
+        // so check for bijectivity up front, not just length and bounds
+        crate::error::validate_permutation(permutation, self.indices.len())?;
+
+        let sign = self.permutation_sign(permutation);
+
+        // Walk each cycle once, entering it only from its smallest slot so
+        // no visited marks are needed
+        for start in 0..permutation.len() {
+            let mut probe = permutation[start];
+            while probe > start {
+                probe = permutation[probe];
+            }
+            if probe < start {
+                continue; // cycle already handled from a smaller slot
+            }
+            let mut slot = start;
+            loop {
+                let from = permutation[slot];
+                if from == start {
+                    break;
+                }
+                self.indices.swap(slot, from);
+                slot = from;
+            }
+        }
+
+        // Remap contracted slots: old slot `permutation[i]` lands in slot
+        // `i`; contractions are few, so a scan per slot beats building the
+        // inverse table
+        for k in 0..self.contractions.len() {
+            let (u, l) = self.contractions[k];
+            let new_u = permutation.iter().position(|&p| p == u);
+            let new_l = permutation.iter().position(|&p| p == l);
+            if let (Some(u), Some(l)) = (new_u, new_l) {
+                self.contractions[k] = (u, l);
+            }
+        }
+
+        self.coefficient *= sign;
+        Ok(())
+    }
+
+    /// Evaluates a candidate permutation into a reusable scratch buffer
+    ///
+    /// Unlike `permute`, this constructs no `Tensor`: the permuted indices
+    /// land in the candidate's existing allocation and the coefficient is
+    /// computed in place, so scoring thousands of candidates costs no clones
+    /// of the name or the symmetry list. Build the full tensor for the
+    /// winner with `permute`.
+    ///
+    /// # Arguments
+    /// * `permutation` - Array representing the permutation
+    /// * `out` - Scratch buffer receiving the permuted indices and sign
+    pub fn permute_into(&self, permutation: &[usize], out: &mut Candidate) -> crate::Result<()> {
+        if permutation.len() != self.indices.len() {
+            return Err(crate::ButlerPortugalError::InvalidPermutation(format!(
+                "Permutation length {} doesn't match tensor rank {}",
+                permutation.len(),
+                self.indices.len()
+            )));
+        }
+
+        out.indices.clear();
+        for &p in permutation {
+            if p >= self.indices.len() {
+                return Err(crate::ButlerPortugalError::InvalidPermutation(format!(
+                    "Permutation index {p} out of bounds"
+                )));
+            }
+            out.indices.push(self.indices[p]);
+        }
+        out.coefficient = self.coefficient.clone() * self.permutation_sign(permutation);
+        Ok(())
+    }
+
     /// Calculates the sign of a permutation based on tensor symmetries
     fn permutation_sign(&self, permutation: &[usize]) -> i32 {
         let mut sign = 1;
 
         // Count inversions for each symmetry group
-        for symmetry in &self.symmetries {
+        for symmetry in self.symmetries.iter() {
             sign *= symmetry.permutation_sign(permutation);
         }
 
@@ -179,7 +337,7 @@ impl Tensor {
 
     /// Checks if the tensor is zero due to symmetry constraints
     pub fn is_zero(&self) -> bool {
-        self.coefficient == 0
+        self.coefficient.is_zero()
             || self
                 .symmetries
                 .iter()
@@ -196,81 +354,377 @@ impl Tensor {
     /// The projected tensor (or an error if permutation fails)
     pub fn project_with_tableau(&self, tableau: &StandardTableau) -> crate::Result<Tensor> {
         let degree = self.rank();
-        let perms = young_symmetrizer_permutations(tableau, degree);
-        let mut result = None;
-        for (perm, sign) in &perms {
-            let mut t = self.permute(perm)?;
-            t.set_coefficient(t.coefficient() * sign);
-            result = match result {
-                Some(acc) => Some(add_tensors(&acc, &t)?),
-                None => Some(t),
-            };
-        }
-        let mut result = result.ok_or_else(|| {
-            crate::ButlerPortugalError::InvalidPermutation(
+
+        // Hook content check: with fewer distinct index names than the shape
+        // has rows, the column antisymmetrizers annihilate every term, so
+        // skip the symmetrizer walk entirely
+        let distinct_names: HashSet<&str> = self.indices.iter().map(|idx| idx.name()).collect();
+        if tableau.shape().dimension_with_labels(distinct_names.len()) == 0 {
+            let mut zero = self.clone();
+            zero.set_coefficient(0);
+            return Ok(zero);
+        }
+
+        // Stream the symmetrizer terms, bucketing coefficients by the packed
+        // canonical index arrangement: each term is evaluated into a scratch
+        // buffer, sorted once, and summed into its bucket, so no per-term
+        // tensor clone or pairwise re-sort happens
+        let mut scratch = Candidate::new();
+        let mut buckets: HashMap<Vec<u64>, Coefficient> = HashMap::new();
+        let mut terms = 0i32;
+        for (perm, sign) in young_symmetrizer(tableau, degree) {
+            self.permute_into(&perm, &mut scratch)?;
+            scratch
+                .indices
+                .sort_unstable_by_key(|idx| (idx.sort_key(), idx.position()));
+            let key: Vec<u64> = scratch
+                .indices
+                .iter()
+                .map(|idx| (u64::from(idx.symbol()) << 1) | u64::from(idx.is_contravariant()))
+                .collect();
+            *buckets.entry(key).or_default() += scratch.coefficient.clone() * sign;
+            terms += 1;
+        }
+
+        crate::canonicalization::record_young_projection(terms.unsigned_abs().into());
+        if terms == 0 {
+            return Err(crate::ButlerPortugalError::InvalidPermutation(
                 "No permutations in Young symmetrizer".to_string(),
-            )
-        })?;
-        // Normalize by the number of terms in the symmetrizer
-        if !perms.is_empty() {
-            result.set_coefficient(result.coefficient() / perms.len() as i32);
+            ));
+        }
+        // Every term is a slot permutation of the same index multiset, so
+        // all buckets coincide; more than one would mean incompatible terms
+        if buckets.len() > 1 {
+            return Err(crate::ButlerPortugalError::IncompatibleTensors(
+                "Cannot add tensors with different indices (by name/variance)".to_string(),
+            ));
+        }
+        let total = buckets
+            .into_values()
+            .fold(Coefficient::default(), |acc, value| acc + value);
+
+        // Materialize once: canonical index order with the normalized sum.
+        // The division by the term count is exact rational arithmetic, so
+        // projections that average to a fraction survive instead of
+        // truncating to an integer.
+        let mut result = self.clone();
+        result
+            .indices
+            .sort_unstable_by_key(|idx| (idx.sort_key(), idx.position()));
+        result.coefficient = total * Coefficient::ratio(1, i64::from(terms));
+        Ok(result)
+    }
+
+    /// Decomposes this tensor into its irreducible components
+    ///
+    /// Every standard tableau of every partition of the rank defines one
+    /// projector; shapes whose hook content vanishes for the tensor's
+    /// distinct index names are skipped up front (their projections are
+    /// identically zero), and the surviving tableaux are enumerated by
+    /// [`StandardTableau::iter_shape`] and projected in parallel, each
+    /// worker pulling the next tableau from a shared atomic cursor as in
+    /// the batch canonicalizer. Components that project to zero are
+    /// dropped; the rest are returned in tableau order.
+    pub fn decompose(&self) -> crate::Result<Vec<Tensor>> {
+        let distinct_names: HashSet<&str> = self.indices.iter().map(|idx| idx.name()).collect();
+        let mut tableaux = Vec::new();
+        for shape in crate::young_tableaux::partitions(self.rank()) {
+            if shape.dimension_with_labels(distinct_names.len()) == 0 {
+                continue;
+            }
+            tableaux.extend(StandardTableau::iter_shape(&shape));
         }
-        // Permute indices to canonical order (by name and variance)
-        let mut indices_with_positions: Vec<(usize, &TensorIndex)> =
-            result.indices.iter().enumerate().collect();
-        indices_with_positions.sort_by(|a, b| a.1.canonical_cmp(b.1));
-        let permutation: Vec<usize> = indices_with_positions.iter().map(|(pos, _)| *pos).collect();
-        let canonical_result = result.permute(&permutation)?;
 
-        // The permutation parity is already handled by the permute method
-        // which applies the sign from tensor symmetries
-        Ok(canonical_result)
+        let workers = std::thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1)
+            .min(tableaux.len());
+        let projections: Vec<crate::Result<Tensor>> = if workers <= 1 {
+            tableaux
+                .iter()
+                .map(|tableau| self.project_with_tableau(tableau))
+                .collect()
+        } else {
+            let cursor = std::sync::atomic::AtomicUsize::new(0);
+            let mut slots: Vec<Option<crate::Result<Tensor>>> =
+                (0..tableaux.len()).map(|_| None).collect();
+            std::thread::scope(|scope| {
+                let mut handles = Vec::with_capacity(workers);
+                for _ in 0..workers {
+                    handles.push(scope.spawn(|| {
+                        let mut out = Vec::new();
+                        loop {
+                            let i = cursor.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                            if i >= tableaux.len() {
+                                break;
+                            }
+                            out.push((i, self.project_with_tableau(&tableaux[i])));
+                        }
+                        out
+                    }));
+                }
+                for handle in handles {
+                    if let Ok(part) = handle.join() {
+                        for (i, result) in part {
+                            slots[i] = Some(result);
+                        }
+                    }
+                }
+            });
+            slots
+                .into_iter()
+                .map(|slot| {
+                    slot.unwrap_or_else(|| {
+                        Err(crate::ButlerPortugalError::ComputationError(
+                            "projection worker thread panicked".to_string(),
+                        ))
+                    })
+                })
+                .collect()
+        };
+
+        let mut components = Vec::new();
+        for projection in projections {
+            let component = projection?;
+            if !component.is_zero() {
+                components.push(component);
+            }
+        }
+        Ok(components)
     }
 }
 
-/// Helper: add two tensors if their names and indices (by name/variance) match, summing coefficients
-fn add_tensors(a: &Tensor, b: &Tensor) -> crate::Result<Tensor> {
-    if a.name() != b.name() {
-        return Err(crate::ButlerPortugalError::IncompatibleTensors(
-            "Cannot add tensors with different names".to_string(),
-        ));
-    }
-    // Normalize indices by name and variance (ignore position)
-    let mut a_indices: Vec<_> = a.indices().iter().collect();
-    let mut b_indices: Vec<_> = b.indices().iter().collect();
-    a_indices.sort_by(|x, y| x.canonical_cmp(y));
-    b_indices.sort_by(|x, y| x.canonical_cmp(y));
-    let indices_match = a_indices
-        .iter()
-        .zip(&b_indices)
-        .all(|(x, y)| x.name() == y.name() && x.is_contravariant() == y.is_contravariant());
-    if indices_match {
-        // Use canonical order for result
-        let mut result = a.clone();
-        result.set_coefficient(a.coefficient() + b.coefficient());
-        // Sort indices to canonical order
-        let mut indices: Vec<_> = result.indices.clone();
-        indices.sort_by(|x, y| x.canonical_cmp(y));
-        result.indices = indices;
-        Ok(result)
-    } else {
-        Err(crate::ButlerPortugalError::IncompatibleTensors(
-            "Cannot add tensors with different indices (by name/variance)".to_string(),
-        ))
+/// A reusable scratch buffer for candidate evaluation
+///
+/// Holds the permuted index arrangement and signed coefficient produced by
+/// `Tensor::permute_into`, reusing its allocation across candidates.
+#[derive(Debug, Clone, Default)]
+pub struct Candidate {
+    indices: Vec<TensorIndex>,
+    coefficient: Coefficient,
+}
+
+impl Candidate {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// The permuted index arrangement of the last evaluation
+    pub fn indices(&self) -> &[TensorIndex] {
+        &self.indices
+    }
+
+    /// The signed coefficient of the last evaluation
+    pub fn coefficient(&self) -> Coefficient {
+        self.coefficient.clone()
+    }
+
+    /// Checks whether the evaluated candidate is zero under the given
+    /// symmetries (mirrors `Tensor::is_zero`)
+    pub fn is_zero(&self, symmetries: &[Symmetry]) -> bool {
+        self.coefficient.is_zero()
+            || symmetries
+                .iter()
+                .any(|s| s.makes_tensor_zero(&self.indices))
+    }
+}
+
+/// A tensor of compile-time rank `R` with inline index storage
+///
+/// Mirrors [`Tensor`] for the small ranks that dominate practice: the
+/// indices live in a stack array, the name and symmetry list are shared
+/// behind `Arc`s, and `permute`/`swap_indices` touch no allocator (except
+/// to remap marked contractions, which most tensors do not carry). Because
+/// the rank is a const parameter, permutation application unrolls at
+/// compile time. Convert from and to `Tensor` at API boundaries with
+/// `TryFrom`/`From`.
+#[derive(Debug, Clone, PartialEq)]
+pub struct FixedTensor<const R: usize> {
+    /// The name/symbol of the tensor, shared between permuted copies
+    name: Arc<str>,
+    /// The indices of the tensor, stored inline
+    indices: [TensorIndex; R],
+    /// Symmetry properties of the tensor, shared between permuted copies
+    symmetries: Arc<[Symmetry]>,
+    /// Contracted (dummy) slot pairs as `(contravariant, covariant)` positions
+    contractions: Arc<[(usize, usize)]>,
+    /// Exact rational coefficient (default is 1)
+    coefficient: Coefficient,
+}
+
+impl<const R: usize> FixedTensor<R> {
+    /// Creates a new fixed-rank tensor with the given name and indices
+    pub fn new(name: &str, indices: [TensorIndex; R]) -> Self {
+        Self {
+            name: Arc::from(name),
+            indices,
+            symmetries: Arc::from(Vec::new()),
+            contractions: Arc::from(Vec::new()),
+            coefficient: Coefficient::integer(1),
+        }
+    }
+
+    /// Returns the name of the tensor
+    pub fn name(&self) -> &str {
+        &self.name
+    }
+
+    /// Returns a reference to the tensor indices
+    pub fn indices(&self) -> &[TensorIndex; R] {
+        &self.indices
+    }
+
+    /// Returns a reference to the symmetries
+    pub fn symmetries(&self) -> &[Symmetry] {
+        &self.symmetries
+    }
+
+    /// Returns the coefficient
+    pub fn coefficient(&self) -> Coefficient {
+        self.coefficient.clone()
+    }
+
+    /// Sets the coefficient
+    pub fn set_coefficient(&mut self, coefficient: impl Into<Coefficient>) {
+        self.coefficient = coefficient.into();
+    }
+
+    /// Returns the rank (number of indices) of the tensor
+    pub fn rank(&self) -> usize {
+        R
+    }
+
+    /// Adds a symmetry property to the tensor
+    pub fn add_symmetry(&mut self, symmetry: Symmetry) {
+        let mut symmetries = self.symmetries.to_vec();
+        symmetries.push(symmetry);
+        self.symmetries = Arc::from(symmetries);
+    }
+
+    /// Swaps two indices at the given positions
+    ///
+    /// Returns the sign change (1 or -1) based on symmetry properties
+    pub fn swap_indices(&mut self, i: usize, j: usize) -> i32 {
+        if i >= R || j >= R || i == j {
+            return 1;
+        }
+
+        self.indices.swap(i, j);
+
+        let mut sign = 1;
+        for symmetry in self.symmetries.iter() {
+            sign *= symmetry.sign_change_for_swap(i, j);
+        }
+
+        self.coefficient *= sign;
+        sign
+    }
+
+    /// Creates a copy of the tensor with permuted indices
+    ///
+    /// The permutation is applied over the inline array, so no allocation
+    /// happens unless contractions have to be remapped.
+    pub fn permute(&self, permutation: &[usize; R]) -> crate::Result<Self> {
+        let mut new_indices = self.indices;
+        for (i, &p) in permutation.iter().enumerate() {
+            if p >= R {
+                return Err(crate::ButlerPortugalError::InvalidPermutation(format!(
+                    "Permutation index {p} out of bounds"
+                )));
+            }
+            new_indices[i] = self.indices[p];
+        }
+
+        // Remap contracted slots: old slot `permutation[i]` lands in slot `i`
+        let mut new_contractions = Arc::clone(&self.contractions);
+        if !new_contractions.is_empty() {
+            let mut new_slot = [0usize; R];
+            for (i, &p) in permutation.iter().enumerate() {
+                new_slot[p] = i;
+            }
+            new_contractions = self
+                .contractions
+                .iter()
+                .map(|&(u, l)| (new_slot[u], new_slot[l]))
+                .collect();
+        }
+
+        let mut sign = 1;
+        for symmetry in self.symmetries.iter() {
+            sign *= symmetry.permutation_sign(permutation);
+        }
+
+        Ok(Self {
+            name: Arc::clone(&self.name),
+            indices: new_indices,
+            symmetries: Arc::clone(&self.symmetries),
+            contractions: new_contractions,
+            coefficient: self.coefficient.clone() * sign,
+        })
+    }
+
+    /// Checks if the tensor is zero due to symmetry constraints
+    pub fn is_zero(&self) -> bool {
+        self.coefficient.is_zero()
+            || self
+                .symmetries
+                .iter()
+                .any(|s| s.makes_tensor_zero(&self.indices))
+    }
+}
+
+impl<const R: usize> TryFrom<&Tensor> for FixedTensor<R> {
+    type Error = crate::ButlerPortugalError;
+
+    fn try_from(tensor: &Tensor) -> crate::Result<Self> {
+        let indices: [TensorIndex; R] = tensor.indices.as_slice().try_into().map_err(|_| {
+            crate::ButlerPortugalError::InvalidTensor(format!(
+                "Tensor rank {} doesn't match fixed rank {R}",
+                tensor.rank()
+            ))
+        })?;
+        Ok(Self {
+            name: Arc::from(tensor.name.as_str()),
+            indices,
+            symmetries: Arc::clone(&tensor.symmetries),
+            contractions: Arc::from(tensor.contractions.as_slice()),
+            coefficient: tensor.coefficient.clone(),
+        })
+    }
+}
+
+impl<const R: usize> From<&FixedTensor<R>> for Tensor {
+    fn from(fixed: &FixedTensor<R>) -> Self {
+        Self {
+            name: fixed.name.to_string(),
+            indices: fixed.indices.to_vec(),
+            symmetries: Arc::clone(&fixed.symmetries),
+            contractions: fixed.contractions.to_vec(),
+            coefficient: fixed.coefficient.clone(),
+        }
     }
 }
 
 impl fmt::Display for Tensor {
     fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
-        if self.coefficient == 0 {
+        if self.coefficient.is_zero() {
             return write!(f, "0");
         }
 
-        let sign = if self.coefficient < 0 { "-" } else { "" };
-        let coeff = if self.coefficient.abs() == 1 {
+        let sign = if self.coefficient.signum() < 0 {
+            "-"
+        } else {
+            ""
+        };
+        let magnitude = if self.coefficient.signum() < 0 {
+            -self.coefficient.clone()
+        } else {
+            self.coefficient.clone()
+        };
+        let coeff = if magnitude.is_one() {
             String::new()
         } else {
-            self.coefficient.abs().to_string()
+            magnitude.to_string()
         };
 
         write!(f, "{}{}{}", sign, coeff, self.name)?;
@@ -327,6 +781,157 @@ mod tests {
         assert_eq!(tensor.coefficient(), -1);
     }
 
+    #[test]
+    fn test_permute_in_place_matches_permute() {
+        let mut tensor = Tensor::new(
+            "R",
+            vec![
+                TensorIndex::new("b", 0),
+                TensorIndex::contravariant("a", 1),
+                TensorIndex::new("a", 2),
+                TensorIndex::new("c", 3),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 3]));
+        if let Err(e) = tensor.add_contraction(1, 2) {
+            panic!("contraction failed: {e}");
+        }
+
+        // A 3-cycle plus a fixed point exercises the cycle walk
+        let perm = [1, 3, 2, 0];
+        let expected = match tensor.permute(&perm) {
+            Ok(t) => t,
+            Err(e) => panic!("permute failed: {e}"),
+        };
+        if let Err(e) = tensor.permute_in_place(&perm) {
+            panic!("permute_in_place failed: {e}");
+        }
+        assert_eq!(tensor, expected);
+
+        // Invalid permutations are rejected before anything is touched,
+        // including non-bijective maps that would stall the cycle walk
+        assert!(tensor.permute_in_place(&[0, 1]).is_err());
+        assert!(tensor.permute_in_place(&[0, 1, 2, 9]).is_err());
+        assert!(tensor.permute_in_place(&[1, 1, 2, 3]).is_err());
+    }
+
+    #[test]
+    fn test_project_with_tableau_is_exact() {
+        // A Custom symmetry admitting only the identity sends the swapped
+        // symmetrizer term to zero, so the symmetric projection averages to
+        // 1/2 - which the old integer coefficient truncated away entirely
+        let mut tensor = Tensor::new(
+            "T",
+            vec![TensorIndex::new("a", 0), TensorIndex::new("b", 1)],
+        );
+        tensor.add_symmetry(Symmetry::custom(vec![vec![0, 1]], vec![1]));
+
+        let shape = crate::young_tableaux::Shape(vec![2]);
+        let Some(tableau) = StandardTableau::new(shape, vec![vec![1, 2]]) else {
+            panic!("tableau construction failed");
+        };
+        let projected = match tensor.project_with_tableau(&tableau) {
+            Ok(t) => t,
+            Err(e) => panic!("projection failed: {e}"),
+        };
+        assert_eq!(projected.coefficient(), Coefficient::ratio(1, 2));
+        assert!(!projected.is_zero());
+    }
+
+    #[test]
+    fn test_decompose_antisymmetric_keeps_only_column_shape() {
+        // F_{ba} antisymmetric: the symmetric projector annihilates it, so
+        // only the [1,1] component survives, in sorted index order
+        let mut tensor = Tensor::new(
+            "F",
+            vec![TensorIndex::new("b", 0), TensorIndex::new("a", 1)],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+
+        let components = match tensor.decompose() {
+            Ok(c) => c,
+            Err(e) => panic!("decompose failed: {e}"),
+        };
+        assert_eq!(components.len(), 1);
+        assert_eq!(components[0].indices()[0].name(), "a");
+        assert_eq!(components[0].indices()[1].name(), "b");
+        assert_eq!(components[0].coefficient(), 1);
+    }
+
+    #[test]
+    fn test_decompose_skips_shapes_beyond_label_count() {
+        // T_{aab}: only two distinct names, so three-row shapes are pruned
+        // before projection and everything left is a genuine component
+        let tensor = Tensor::new(
+            "T",
+            vec![
+                TensorIndex::new("a", 0),
+                TensorIndex::new("a", 1),
+                TensorIndex::new("b", 2),
+            ],
+        );
+
+        let components = match tensor.decompose() {
+            Ok(c) => c,
+            Err(e) => panic!("decompose failed: {e}"),
+        };
+        assert!(!components.is_empty());
+        for component in &components {
+            assert!(!component.is_zero());
+            assert_eq!(component.rank(), 3);
+        }
+    }
+
+    #[test]
+    fn test_fixed_tensor_permute_matches_tensor() {
+        let mut tensor = Tensor::new(
+            "R",
+            vec![
+                TensorIndex::new("b", 0),
+                TensorIndex::new("a", 1),
+                TensorIndex::new("d", 2),
+                TensorIndex::new("c", 3),
+            ],
+        );
+        tensor.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+
+        let fixed: FixedTensor<4> = match (&tensor).try_into() {
+            Ok(f) => f,
+            Err(e) => panic!("conversion failed: {e}"),
+        };
+        let perm = [1, 0, 3, 2];
+        let fixed_permuted = match fixed.permute(&perm) {
+            Ok(f) => f,
+            Err(e) => panic!("fixed permute failed: {e}"),
+        };
+        let tensor_permuted = match tensor.permute(&perm) {
+            Ok(t) => t,
+            Err(e) => panic!("permute failed: {e}"),
+        };
+        assert_eq!(Tensor::from(&fixed_permuted), tensor_permuted);
+    }
+
+    #[test]
+    fn test_fixed_tensor_wrong_rank_conversion() {
+        let tensor = Tensor::new(
+            "T",
+            vec![TensorIndex::new("i", 0), TensorIndex::new("j", 1)],
+        );
+        let result: crate::Result<FixedTensor<3>> = (&tensor).try_into();
+        assert!(result.is_err());
+    }
+
+    #[test]
+    fn test_fixed_tensor_swap_indices() {
+        let mut fixed = FixedTensor::new("A", [TensorIndex::new("i", 0), TensorIndex::new("j", 1)]);
+        fixed.add_symmetry(Symmetry::antisymmetric(vec![0, 1]));
+
+        let sign = fixed.swap_indices(0, 1);
+        assert_eq!(sign, -1);
+        assert_eq!(fixed.coefficient(), -1);
+        assert_eq!(fixed.indices()[0].name(), "j");
+    }
+
     #[test]
     fn test_tensor_display() {
         let tensor = Tensor::new(
@@ -20,6 +20,52 @@ impl Shape {
     pub fn cols(&self) -> usize {
         self.0.iter().max().copied().unwrap_or(0)
     }
+
+    /// Hook length of each cell: cells to the right, cells below, plus one
+    fn hook_lengths(&self) -> Vec<usize> {
+        let mut hooks = Vec::with_capacity(self.size());
+        for (i, &row_len) in self.0.iter().enumerate() {
+            for j in 0..row_len {
+                let arm = row_len - j - 1;
+                let leg = self.0[i + 1..].iter().filter(|&&r| r > j).count();
+                hooks.push(arm + leg + 1);
+            }
+        }
+        hooks
+    }
+
+    /// Dimension of the corresponding irreducible representation of S_n,
+    /// by the hook length formula: n! / (product of hook lengths)
+    pub fn dimension(&self) -> usize {
+        let n = self.size();
+        let mut numerator: u128 = 1;
+        for k in 1..=n {
+            numerator *= k as u128;
+        }
+        let denominator: u128 = self.hook_lengths().iter().map(|&h| h as u128).product();
+        (numerator / denominator.max(1)) as usize
+    }
+
+    /// Number of semistandard fillings with entries from `labels` distinct
+    /// values, by the hook content formula: product over cells of
+    /// (labels + j - i) / hook. Zero exactly when the shape has more rows
+    /// than there are distinct labels, in which case any projection onto
+    /// this shape annihilates a tensor whose indices draw from that label
+    /// set.
+    pub fn dimension_with_labels(&self, labels: usize) -> usize {
+        if self.rows() > labels {
+            return 0;
+        }
+        let mut numerator: u128 = 1;
+        for (i, &row_len) in self.0.iter().enumerate() {
+            for j in 0..row_len {
+                // Content j - i is > -labels here since i < rows <= labels
+                numerator *= (labels + j - i) as u128;
+            }
+        }
+        let denominator: u128 = self.hook_lengths().iter().map(|&h| h as u128).product();
+        (numerator / denominator.max(1)) as usize
+    }
 }
 
 /// A standard Young tableau: filling of a shape with 1..n, increasing in rows and columns
@@ -70,6 +116,19 @@ impl StandardTableau {
         self.shape.size()
     }
 
+    /// Lazily enumerates all standard tableaux of a shape
+    ///
+    /// Entries 1..n are placed one at a time, each into a row that is not
+    /// full and is strictly less filled than the row above - the invariant
+    /// that makes every completed filling standard - so only valid
+    /// tableaux are ever built, instead of filtering the n! fillings
+    /// through [`StandardTableau::new`]. The number yielded equals
+    /// [`Shape::dimension`]. A shape whose rows are not weakly decreasing
+    /// is not a partition and yields nothing.
+    pub fn iter_shape(shape: &Shape) -> ShapeTableaux {
+        ShapeTableaux::new(shape)
+    }
+
     /// Returns the row reading word
     pub fn row_reading_word(&self) -> Vec<usize> {
         self.entries
@@ -105,6 +164,124 @@ impl fmt::Display for StandardTableau {
     }
 }
 
+/// Lazy enumerator of the standard tableaux of one shape; see
+/// [`StandardTableau::iter_shape`]
+pub struct ShapeTableaux {
+    shape: Shape,
+    /// Row receiving entry k+1, for each entry placed so far
+    choices: Vec<usize>,
+    /// Cells filled so far in each row
+    fill: Vec<usize>,
+    started: bool,
+    done: bool,
+}
+
+impl ShapeTableaux {
+    fn new(shape: &Shape) -> Self {
+        // Rows must weakly decrease for the fill invariant to be the
+        // standardness condition; anything else is not a Young diagram
+        let done = shape.0.windows(2).any(|w| w[1] > w[0]);
+        Self {
+            shape: shape.clone(),
+            choices: Vec::with_capacity(shape.size()),
+            fill: vec![0; shape.rows()],
+            started: false,
+            done,
+        }
+    }
+
+    /// First row at or after `from` that can legally receive the next
+    /// entry: not full, and strictly less filled than the row above (so the
+    /// entry sits below a smaller one)
+    fn next_row(&self, from: usize) -> Option<usize> {
+        (from..self.shape.rows()).find(|&r| {
+            self.fill[r] < self.shape.0[r] && (r == 0 || self.fill[r] < self.fill[r - 1])
+        })
+    }
+
+    fn place(&mut self, row: usize) {
+        self.choices.push(row);
+        self.fill[row] += 1;
+    }
+
+    fn build(&self) -> StandardTableau {
+        let mut entries: Vec<Vec<usize>> = self
+            .shape
+            .0
+            .iter()
+            .map(|&l| Vec::with_capacity(l))
+            .collect();
+        for (entry, &row) in self.choices.iter().enumerate() {
+            entries[row].push(entry + 1);
+        }
+        StandardTableau {
+            shape: self.shape.clone(),
+            entries,
+        }
+    }
+}
+
+impl Iterator for ShapeTableaux {
+    type Item = StandardTableau;
+
+    fn next(&mut self) -> Option<StandardTableau> {
+        if self.done {
+            return None;
+        }
+
+        if self.started {
+            // Backtrack from the previous tableau to the next choice point:
+            // pop entries until some popped row admits a later alternative
+            loop {
+                let Some(last) = self.choices.pop() else {
+                    self.done = true;
+                    return None;
+                };
+                self.fill[last] -= 1;
+                if let Some(row) = self.next_row(last + 1) {
+                    self.place(row);
+                    break;
+                }
+            }
+        }
+        self.started = true;
+
+        // Descend greedily; every valid partial filling of a partition
+        // extends, so this always completes
+        while self.choices.len() < self.shape.size() {
+            let Some(row) = self.next_row(0) else {
+                self.done = true;
+                return None;
+            };
+            self.place(row);
+        }
+        if self.choices.is_empty() {
+            // The empty shape has exactly one (empty) tableau
+            self.done = true;
+        }
+        Some(self.build())
+    }
+}
+
+/// All partitions of `n` as shapes, largest first row first (the order the
+/// parts are peeled off a decreasing sequence)
+pub fn partitions(n: usize) -> Vec<Shape> {
+    fn fill(remaining: usize, max_part: usize, current: &mut Vec<usize>, out: &mut Vec<Shape>) {
+        if remaining == 0 {
+            out.push(Shape(current.clone()));
+            return;
+        }
+        for part in (1..=remaining.min(max_part)).rev() {
+            current.push(part);
+            fill(remaining - part, part, current, out);
+            current.pop();
+        }
+    }
+    let mut out = Vec::new();
+    fill(n, n, &mut Vec::new(), &mut out);
+    out
+}
+
 /// A semistandard Young tableau: entries weakly increase in rows, strictly in columns
 #[derive(Debug, Clone, PartialEq, Eq, Hash)]
 pub struct SemistandardTableau {
@@ -197,73 +374,124 @@ pub fn young_symmetrizer_permutations(
     tableau: &StandardTableau,
     degree: usize,
 ) -> Vec<(Vec<usize>, i32)> {
-    // Row symmetrizer: sum over all permutations within each row (symmetrize rows)
-    let mut row_group = vec![(0..degree).collect::<Vec<_>>()];
+    young_symmetrizer(tableau, degree).collect()
+}
+
+/// Lazily yields the `(permutation, sign)` pairs of the Young symmetrizer
+///
+/// Equivalent to [`young_symmetrizer_permutations`], but the full
+/// row-group x column-group product is never materialized: only the
+/// per-row and per-column subgroup factors are held (at most k! elements
+/// for a factor of k cells), and each call to `next` composes one
+/// combination via a mixed-radix counter over the factors. Projecting
+/// against a large symmetrizer therefore runs in memory proportional to
+/// the sum of the factor sizes rather than their product.
+///
+/// # Arguments
+/// * `tableau` - The standard tableau specifying the symmetry type
+/// * `degree` - The number of slots/indices (should match tableau size)
+pub fn young_symmetrizer(tableau: &StandardTableau, degree: usize) -> YoungSymmetrizer {
+    let mut factors: Vec<Vec<(Vec<usize>, i32)>> = Vec::new();
+
+    // Row symmetrizer factors: all permutations within each row, sign +1
     for row in &tableau.entries {
-        let mut new_group = Vec::new();
-        for perm in row.clone().into_iter().permutations(row.len()).unique() {
-            let mut p = (0..degree).collect::<Vec<_>>();
-            for (i, &slot) in perm.iter().enumerate() {
-                if i < row.len() && slot > 0 && (slot - 1) < row.len() {
-                    p[row[i] - 1] = row[slot - 1] - 1;
-                }
-            }
-            for g in &row_group {
-                let composed = compose_permutations(g, &p);
-                new_group.push(composed);
-            }
+        if row.len() <= 1 {
+            continue;
         }
-        row_group = new_group;
+        factors.push(cell_group_elements(row, degree, false));
     }
-    // Column antisymmetrizer: sum over all permutations within each column (antisymmetrize columns)
+
+    // Column antisymmetrizer factors: all permutations within each column,
+    // signed by parity
     let cols = tableau.shape.cols();
-    let mut col_group = vec![((0..degree).collect::<Vec<usize>>(), 1)];
     for j in 0..cols {
-        // Collect the column indices
-        let mut col_indices = Vec::new();
-        for row in tableau.entries.iter() {
-            if j < row.len() {
-                col_indices.push(row[j]);
-            }
-        }
-        if col_indices.len() <= 1 {
+        let col_cells: Vec<usize> = tableau
+            .entries
+            .iter()
+            .filter(|row| j < row.len())
+            .map(|row| row[j])
+            .collect();
+        if col_cells.len() <= 1 {
             continue;
         }
-        let mut new_group = Vec::new();
-        for perm in col_indices
-            .clone()
-            .into_iter()
-            .permutations(col_indices.len())
-            .unique()
-        {
-            if perm.len() != col_indices.len() {
-                continue; // Defensive: skip malformed permutations
-            }
-            let mut p = (0..degree).collect::<Vec<_>>();
-            let perm_vec: Vec<usize> = perm.iter().map(|&x| x - 1).collect();
-            let sign = permutation_parity_usize(&perm_vec);
-            for (i, &slot) in perm.iter().enumerate() {
-                if i >= col_indices.len() {
-                    continue;
-                } // Defensive: skip out-of-bounds
-                p[col_indices[i] - 1] = slot - 1;
-            }
-            for (g, s) in &col_group {
-                let composed = compose_permutations(g, &p);
-                new_group.push((composed, s * sign));
-            }
+        factors.push(cell_group_elements(&col_cells, degree, true));
+    }
+
+    let counters = vec![0; factors.len()];
+    YoungSymmetrizer {
+        degree,
+        factors,
+        counters,
+        done: false,
+    }
+}
+
+/// All permutations of the given tableau cells as degree-wide permutations,
+/// with parity signs when `signed` (antisymmetrizer) or +1 otherwise
+fn cell_group_elements(cells: &[usize], degree: usize, signed: bool) -> Vec<(Vec<usize>, i32)> {
+    let k = cells.len();
+    let mut elements = Vec::new();
+    for positions in (0..k).permutations(k) {
+        let mut p = (0..degree).collect::<Vec<_>>();
+        for (i, &pos) in positions.iter().enumerate() {
+            p[cells[i] - 1] = cells[pos] - 1;
         }
-        col_group = new_group;
-    }
-    // Combine row symmetrizer and column antisymmetrizer
-    let mut result = Vec::new();
-    for g in row_group {
-        for (h, sign) in &col_group {
-            let composed = compose_permutations(&g, h);
-            result.push((composed, *sign));
+        let sign = if signed {
+            permutation_parity_usize(&positions)
+        } else {
+            1
+        };
+        elements.push((p, sign));
+    }
+    elements
+}
+
+/// Lazy iterator over the Young symmetrizer's `(permutation, sign)` pairs;
+/// see [`young_symmetrizer`]
+pub struct YoungSymmetrizer {
+    /// The number of slots each yielded permutation acts on
+    degree: usize,
+    /// Per-row and per-column subgroup elements, in composition order
+    factors: Vec<Vec<(Vec<usize>, i32)>>,
+    /// Mixed-radix counter selecting one element from each factor
+    counters: Vec<usize>,
+    done: bool,
+}
+
+impl Iterator for YoungSymmetrizer {
+    type Item = (Vec<usize>, i32);
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.done {
+            return None;
+        }
+
+        // Compose the selected element of every factor, accumulating the sign
+        let mut perm: Option<Vec<usize>> = None;
+        let mut sign = 1;
+        for (factor, &c) in self.factors.iter().zip(&self.counters) {
+            let (p, s) = &factor[c];
+            perm = Some(match perm {
+                Some(acc) => compose_permutations(&acc, p),
+                None => p.clone(),
+            });
+            sign *= s;
+        }
+        let perm = perm.unwrap_or_else(|| (0..self.degree).collect());
+
+        // Advance the mixed-radix counter; exhaustion ends the iterator
+        self.done = true;
+        for (c, factor) in self.counters.iter_mut().zip(&self.factors).rev() {
+            *c += 1;
+            if *c < factor.len() {
+                self.done = false;
+                break;
+            }
+            *c = 0;
         }
+
+        Some((perm, sign))
     }
-    result
 }
 
 /// Helper: parity of a permutation (usize version)
@@ -330,6 +558,97 @@ mod tests {
         assert!(t.is_none());
     }
 
+    #[test]
+    fn test_hook_length_dimension() {
+        assert_eq!(Shape(vec![2, 1]).dimension(), 2);
+        assert_eq!(Shape(vec![3]).dimension(), 1);
+        assert_eq!(Shape(vec![1, 1, 1]).dimension(), 1);
+    }
+
+    #[test]
+    fn test_dimension_with_labels() {
+        // Fewer distinct labels than rows: every filling needs a strictly
+        // increasing first column, so the count is zero
+        assert_eq!(Shape(vec![1, 1, 1]).dimension_with_labels(2), 0);
+        assert_eq!(Shape(vec![1, 1, 1]).dimension_with_labels(3), 1);
+        // Weakly increasing rows of length 2 from 3 labels: C(4, 2)
+        assert_eq!(Shape(vec![2]).dimension_with_labels(3), 6);
+    }
+
+    #[test]
+    fn test_young_symmetrizer_streams_all_terms() {
+        let shape = Shape(vec![2, 1]);
+        let Some(tableau) = StandardTableau::new(shape, vec![vec![1, 2], vec![3]]) else {
+            panic!("tableau must be standard")
+        };
+
+        // Row factor (2 terms) x column factor (2 signed terms)
+        let terms: Vec<(Vec<usize>, i32)> = young_symmetrizer(&tableau, 3).collect();
+        assert_eq!(terms.len(), 4);
+        assert_eq!(terms.iter().map(|(_, s)| s).sum::<i32>(), 0);
+        assert!(terms.iter().any(|(p, s)| *p == vec![0, 1, 2] && *s == 1));
+        assert_eq!(terms, young_symmetrizer_permutations(&tableau, 3));
+    }
+
+    #[test]
+    fn test_young_symmetrizer_single_column_signs() {
+        let shape = Shape(vec![1, 1]);
+        let Some(tableau) = StandardTableau::new(shape, vec![vec![1], vec![2]]) else {
+            panic!("tableau must be standard")
+        };
+
+        let terms: Vec<(Vec<usize>, i32)> = young_symmetrizer(&tableau, 2).collect();
+        assert_eq!(terms.len(), 2);
+        assert!(terms.contains(&(vec![0, 1], 1)));
+        assert!(terms.contains(&(vec![1, 0], -1)));
+    }
+
+    #[test]
+    fn test_iter_shape_counts_match_hook_formula() {
+        for shape in [
+            Shape(vec![3]),
+            Shape(vec![2, 1]),
+            Shape(vec![2, 2]),
+            Shape(vec![3, 2, 1]),
+            Shape(vec![1, 1, 1, 1]),
+        ] {
+            let tableaux: Vec<StandardTableau> = StandardTableau::iter_shape(&shape).collect();
+            assert_eq!(tableaux.len(), shape.dimension(), "shape {:?}", shape.0);
+            // Everything yielded passes the full standardness validation
+            for tableau in &tableaux {
+                assert!(
+                    StandardTableau::new(shape.clone(), tableau.entries.clone()).is_some(),
+                    "non-standard tableau for shape {:?}",
+                    shape.0
+                );
+            }
+            // And no tableau is yielded twice
+            for (i, a) in tableaux.iter().enumerate() {
+                assert!(!tableaux[i + 1..].contains(a));
+            }
+        }
+    }
+
+    #[test]
+    fn test_iter_shape_rejects_non_partition() {
+        let tableaux: Vec<StandardTableau> =
+            StandardTableau::iter_shape(&Shape(vec![1, 2])).collect();
+        assert!(tableaux.is_empty());
+    }
+
+    #[test]
+    fn test_partitions() {
+        let shapes = partitions(4);
+        assert_eq!(shapes.len(), 5);
+        assert_eq!(shapes[0], Shape(vec![4]));
+        assert_eq!(shapes[4], Shape(vec![1, 1, 1, 1]));
+        // Every shape partitions 4 with weakly decreasing rows
+        for shape in &shapes {
+            assert_eq!(shape.size(), 4);
+            assert!(shape.0.windows(2).all(|w| w[0] >= w[1]));
+        }
+    }
+
     #[test]
     fn test_rsk() {
         let word = vec![3, 1, 2, 1];